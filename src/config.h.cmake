@@ -50,6 +50,12 @@
 /* Define if JACK MIDI support is enabled. */
 #cmakedefine CONFIG_JACK_MIDI @CONFIG_JACK_MIDI@
 
+/* Define if JACK latency callback is available. */
+#cmakedefine CONFIG_JACK_LATENCY @CONFIG_JACK_LATENCY@
+
+/* Define if JACK metadata support is available. */
+#cmakedefine CONFIG_JACK_METADATA @CONFIG_JACK_METADATA@
+
 /* Define if LV2 plug-in build is enabled. */
 #cmakedefine CONFIG_LV2 @CONFIG_LV2@
 
@@ -95,5 +101,11 @@
 /* Define if NSM support is available. */
 #cmakedefine CONFIG_NSM @CONFIG_NSM@
 
+/* Define if runtime CPU dispatch of DSP kernels is enabled. */
+#cmakedefine CONFIG_CPU_DISPATCH @CONFIG_CPU_DISPATCH@
+
+/* Define if persistent (on-disk) wave tables cache is enabled. */
+#cmakedefine CONFIG_WAVE_CACHE @CONFIG_WAVE_CACHE@
+
 
 #endif /* CONFIG_H */
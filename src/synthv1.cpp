@@ -1,7 +1,7 @@
 // synthv1.cpp
 //
 /****************************************************************************
-   Copyright (C) 2012-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -24,7 +24,7 @@
 #include "synthv1_wave.h"
 #include "synthv1_ramp.h"
 
-#include "synthv1_list.h"
+#include "synthv1_bank.h"
 
 #include "synthv1_filter.h"
 #include "synthv1_formant.h"
@@ -38,6 +38,9 @@
 #include "synthv1_tuning.h"
 
 #include "synthv1_sched.h"
+#include "synthv1_pool.h"
+
+#include "synthv1_cpu.h"
 
 
 #ifdef CONFIG_DEBUG_0
@@ -45,6 +48,7 @@
 #endif
 
 #include <cstring>
+#include <utility>
 
 
 //-------------------------------------------------------------------------
@@ -54,8 +58,10 @@
 //    Copyright (C) 2007 jorgen, linux-vst.com
 //
 
-const uint8_t MAX_VOICES  = 64;			// max polyphony
-const uint8_t MAX_NOTES   = 128;
+const uint16_t MAX_VOICES = 256;		// max polyphony (upper limit)
+const uint16_t DEF_VOICES = 64;			// default polyphony
+const uint16_t STEAL_VOICES = 8;		// spare voices (fading out when stolen)
+const uint8_t  MAX_NOTES  = 128;
 
 const float MIN_ENV_MSECS = 0.5f;		// min 500 usec per stage
 const float MAX_ENV_MSECS = 5000.0f;	// max 5 sec per stage (default)
@@ -67,7 +73,11 @@ const float TUNING_SCALE  = 1.0f;
 const float SWEEP_SCALE   = 0.5f;
 const float PITCH_SCALE   = 0.5f;
 
-const uint8_t MAX_DIRECT_NOTES = (MAX_VOICES >> 2);
+const uint8_t MAX_DIRECT_NOTES = (DEF_VOICES >> 2);
+
+const uint8_t MAX_SLICES  = 16;			// parallel voice slices (fixed)
+
+const uint16_t MAX_CTL_FRAMES = 64;		// control-rate period (upper limit)
 
 
 // maximum helper
@@ -227,6 +237,14 @@ public:
 		return m_vtick;
 	}
 
+	// current ramp state (block snapshots).
+	float vtick() const
+		{ return (m_nstep > 0 ? m_vtick : synthv1_port::value()); }
+	float vstep() const
+		{ return m_vstep; }
+	uint32_t nstep() const
+		{ return m_nstep; }
+
 private:
 
 	float    m_vtick;
@@ -287,16 +305,19 @@ struct synthv1_env
 		p->c0 = 0.0f;
 	}
 
+	// next stage: parameters are read as of last update(),
+	// as voice rendering may run on several threads at once.
 	void next(State *p)
 	{
 		if (p->stage == Attack) {
 			p->stage = Decay;
-			p->frames = uint32_t(*decay * *decay * max_frames);
+			const float decay_v = decay.value();
+			p->frames = uint32_t(decay_v * decay_v * max_frames);
 			if (p->frames < min_frames2) // prevent click on too fast decay
 				p->frames = min_frames2;
 			p->phase = 0.0f;
 			p->delta = 1.0f / float(p->frames);
-			p->c1 = *sustain - 1.0f;
+			p->c1 = sustain.value() - 1.0f;
 			p->c0 = p->value;
 		}
 		else if (p->stage == Decay) {
@@ -366,6 +387,15 @@ struct synthv1_env
 		}
 	}
 
+	// update parameters (once per block)
+	void update()
+	{
+		attack.tick(1);
+		decay.tick(1);
+		sustain.tick(1);
+		release.tick(1);
+	}
+
 	// parameters
 
 	synthv1_port attack;
@@ -424,6 +454,7 @@ struct synthv1_dco
 	synthv1_port tuning;
 	synthv1_port glide;
 	synthv1_port envtime;
+	synthv1_port polyblep;
 
 	float envtime0;
 };
@@ -572,6 +603,139 @@ struct synthv1_dyn
 };
 
 
+// block parameter snapshot (per synth)
+
+struct synthv1_snap
+{
+	// smoothed parameter, linearly ramped along the block
+	// (per frame offset, as the port would have ticked).
+	struct Ramp
+	{
+		void update(synthv1_port2& port, uint32_t nframes)
+		{
+			port.tick(0); // any port change starts ramping now...
+
+			value0 = port.vtick();
+			vstep  = port.vstep();
+			nstep  = port.nstep();
+
+			if (nstep > nframes)
+				nstep = nframes;
+
+			port.tick(nframes);
+		}
+
+		float value(uint32_t n) const
+			{ return value0 + vstep * float(n < nstep ? n : nstep); }
+
+		float    value0;
+		float    vstep;
+		uint32_t nstep;
+	};
+
+	void update(synthv1_dco& dco, synthv1_dcf& dcf,
+		synthv1_lfo& lfo, synthv1_out& out, uint32_t nframes)
+	{
+		dco_ringmod  = dco.ringmod.tick(nframes);
+
+		dcf_enabled  = (dcf.enabled.tick(nframes) > 0.0f);
+		dcf_slope    = int(dcf.slope.tick(nframes));
+		dcf_cutoff.update(dcf.cutoff, nframes);
+		dcf_reso.update(dcf.reso, nframes);
+		dcf_envelope.update(dcf.envelope, nframes);
+
+		lfo_enabled  = (lfo.enabled.tick(nframes) > 0.0f);
+		lfo_bpm      = lfo.bpm.tick(nframes);
+		lfo_rate     = lfo.rate.tick(nframes);
+		lfo_sweep.update(lfo.sweep, nframes);
+		lfo_pitch    = lfo.pitch.tick(nframes);
+		lfo_balance  = lfo.balance.tick(nframes);
+		lfo_ringmod.update(lfo.ringmod, nframes);
+		lfo_cutoff.update(lfo.cutoff, nframes);
+		lfo_reso.update(lfo.reso, nframes);
+		lfo_panning  = lfo.panning.tick(nframes);
+		lfo_volume   = lfo.volume.tick(nframes);
+
+		const float fxsend = out.fxsend.tick(nframes);
+		out_fxsend   = fxsend * fxsend;
+	}
+
+	float dco_ringmod;
+
+	bool  dcf_enabled;
+	int   dcf_slope;
+	Ramp  dcf_cutoff;
+	Ramp  dcf_reso;
+	Ramp  dcf_envelope;
+
+	bool  lfo_enabled;
+	float lfo_bpm;
+	float lfo_rate;
+	Ramp  lfo_sweep;
+	float lfo_pitch;
+	float lfo_balance;
+	Ramp  lfo_ringmod;
+	Ramp  lfo_cutoff;
+	Ramp  lfo_reso;
+	float lfo_panning;
+	float lfo_volume;
+
+	float out_fxsend;
+
+	float lfo_freq;
+	float modwheel;
+};
+
+
+// control-rate modulation, linearly interpolated (per voice)
+
+struct synthv1_ctlr
+{
+	enum Index {
+		Lfo1 = 0, Lfo2, RingMod1, RingMod2,
+		Cutoff1, Reso1, Cutoff2, Reso2, NUM_VALUES };
+
+	synthv1_ctlr() : running(false), frames(0)
+	{
+		for (uint16_t i = 0; i < NUM_VALUES; ++i)
+			value[i] = delta[i] = 0.0f;
+	}
+
+	void reset() { running = false; frames = 0; }
+
+	// ramp towards next control point, along the next nframes.
+	void reset(const float *target, uint32_t nframes)
+	{
+		if (running) {
+			const float ratio = 1.0f / float(nframes);
+			for (uint16_t i = 0; i < NUM_VALUES; ++i)
+				delta[i] = (target[i] - value[i]) * ratio;
+		} else {
+			for (uint16_t i = 0; i < NUM_VALUES; ++i) {
+				value[i] = target[i];
+				delta[i] = 0.0f;
+			}
+			running = true;
+		}
+
+		frames = nframes;
+	}
+
+	void tick()
+	{
+		for (uint16_t i = 0; i < NUM_VALUES; ++i)
+			value[i] += delta[i];
+		--frames;
+	}
+
+	bool running;
+	uint32_t frames;
+
+	float value[NUM_VALUES];
+	float delta[NUM_VALUES];
+};
+
+
 // keyboard/note range
 
 struct synthv1_key
@@ -725,16 +889,13 @@ private:
 class synthv1_impl;
 
 
-// voice
+// voice (per sample state first, note-on/bookkeeping state last)
 
-struct synthv1_voice : public synthv1_list<synthv1_voice>
+struct alignas(64) synthv1_voice
 {
 	synthv1_voice(synthv1_impl *pImpl);
 
-	int note1, note2;							// voice note
-
 	float vel1, vel2;							// key velocity
-	float pre1, pre2;							// key pressure/after-touch
 
 	synthv1_oscillator dco11, dco12;			// oscillators
 	synthv1_oscillator dco21, dco22;
@@ -750,12 +911,17 @@ struct synthv1_voice : public synthv1_list<synthv1_voice>
 
 	float dco1_balance, dco2_balance;
 
-	synthv1_bal2 dco1_bal, dco2_bal;			// oscillators balance
+	float out1_panning, out2_panning;
+	float out1_volume, out2_volume;
+
+	synthv1_ctlr ctlr;							// control-rate modulators
 
-	synthv1_filter1 dcf11, dcf12, dcf21, dcf22;	// filters
-	synthv1_filter2 dcf13, dcf14, dcf23, dcf24;
-	synthv1_filter3 dcf15, dcf16, dcf25, dcf26;
-	synthv1_formant dcf17, dcf18, dcf27, dcf28;
+	synthv1_filter1_quad dcfq1;					// filters (quad lanes:
+	synthv1_filter2_quad dcfq2;					// dcf11, dcf12, dcf21, dcf22)
+	synthv1_filter3_quad dcfq3;
+
+	synthv1_halfband_quad<6>  over42;			// oversampling decimators
+	synthv1_halfband_quad<16> over21;			// (4x to 2x, 2x to 1x)
 
 	synthv1_env::State dca1_env, dca2_env;		// envelope states
 	synthv1_env::State dcf1_env, dcf2_env;
@@ -764,15 +930,23 @@ struct synthv1_voice : public synthv1_list<synthv1_voice>
 	synthv1_glide dco1_glide1, dco1_glide2;		// glides (portamento)
 	synthv1_glide dco2_glide1, dco2_glide2;
 
-	synthv1_pre dca1_pre, dca2_pre;
+	synthv1_bal2 dco1_bal, dco2_bal;			// oscillators balance
 
-	float out1_panning, out2_panning;
-	float out1_volume, out2_volume;
+	synthv1_pre dca1_pre, dca2_pre;
 
 	synthv1_bal1  out1_pan, out2_pan;			// output panning
 	synthv1_ramp1 out1_vol, out2_vol;			// output volume
 
+	int note1, note2;							// voice note
+	int key;									// last note key (stealing)
+
+	float pre1, pre2;							// key pressure/after-touch
+
 	bool sustain1, sustain2;
+
+	bool stolen;								// fading out (stolen)
+
+	synthv1_formant dcf17, dcf18, dcf27, dcf28;	// formant filters
 };
 
 
@@ -826,13 +1000,46 @@ public:
 };
 
 
+// voice slice rendering job (parallel)
+
+class synthv1_slice_job : public synthv1_pool::Job
+{
+public:
+
+	synthv1_slice_job (synthv1_impl *pImpl) : m_pImpl(pImpl) {}
+
+	void process(uint32_t islice);
+
+private:
+
+	synthv1_impl *m_pImpl;
+};
+
+
+// effects chain pipelined job (single slice)
+
+class synthv1_fx_job : public synthv1_pool::Job
+{
+public:
+
+	synthv1_fx_job (synthv1_impl *pImpl) : m_pImpl(pImpl) {}
+
+	void process(uint32_t islice);
+
+private:
+
+	synthv1_impl *m_pImpl;
+};
+
+
 // polyphonic synth implementation
 
 class synthv1_impl
 {
 public:
 
-	synthv1_impl(synthv1 *pSynth, uint16_t nchannels, float srate, uint32_t nsize);
+	synthv1_impl(synthv1 *pSynth, uint16_t nchannels,
+		float srate, uint32_t nsize, uint16_t nvoices);
 
 	~synthv1_impl();
 
@@ -848,6 +1055,8 @@ public:
 	void setTempo(float bpm);
 	float tempo() const;
 
+	uint16_t polyphony() const;
+
 	void setParamPort(synthv1::ParamIndex index, float *pfParam);
 	synthv1_port *paramPort(synthv1::ParamIndex index);
 
@@ -885,8 +1094,39 @@ public:
 
 	void directNoteOn(int note, int vel);
 
+	void setVoiceThreads(uint16_t nthreads);
+	uint16_t voiceThreads() const;
+
+	void setVoiceSteal(synthv1::VoiceSteal steal);
+	synthv1::VoiceSteal voiceSteal() const;
+
+	void setControlRate(uint16_t nframes);
+	uint16_t controlRate() const;
+
+	void setCpuLevel(synthv1::CpuLevel level);
+	synthv1::CpuLevel cpuLevel() const;
+
+	void setInterpolation(synthv1::Interp interp);
+	synthv1::Interp interpolation() const;
+
+	void setOversampling(synthv1::Oversample over);
+	synthv1::Oversample oversampling() const;
+
+	void setWidthMorph(bool wmorph);
+	bool isWidthMorph() const;
+
+	void setFxPipeline(uint32_t nframes);
+	uint32_t fxPipeline() const;
+
+	uint32_t latency() const;
+
+	void process_slice(uint32_t islice);
+	void process_fx_job();
+
 	bool running(bool on);
 
+	bool isIdle() const;
+
 	synthv1_wave dco1_wave1, dco1_wave2;
 	synthv1_wave dco2_wave1, dco2_wave2;
 
@@ -921,17 +1161,53 @@ protected:
 	float get_bpm ( float bpm ) const
 		{ return (bpm > 0.0f ? bpm : m_bpm); }
 
-	synthv1_voice *alloc_voice ()
+	synthv1_voice *alloc_voice ( int key )
 	{
-		synthv1_voice *pv = m_free_list.next();
+		// polyphony exhausted?
+		if (m_nvoices - m_nstolen >= m_polyphony) {
+			synthv1_voice *pv = steal_voice(key);
+			if (pv == nullptr)
+				return nullptr;
+			if (m_voices.free_count() > 0) {
+				// anti-click fade out, on a spare voice...
+				m_dca1.env.note_off_fast(&pv->dca1_env);
+				m_dcf1.env.note_off_fast(&pv->dcf1_env);
+				m_lfo1.env.note_off_fast(&pv->lfo1_env);
+				m_dca2.env.note_off_fast(&pv->dca2_env);
+				m_dcf2.env.note_off_fast(&pv->dcf2_env);
+				m_lfo2.env.note_off_fast(&pv->lfo2_env);
+				if (pv->note1 >= 0) {
+					m_note1[pv->note1] = nullptr;
+					pv->note1 = -1;
+				}
+				if (pv->note2 >= 0) {
+					m_note2[pv->note2] = nullptr;
+					pv->note2 = -1;
+				}
+				pv->stolen = true;
+				++m_nstolen;
+			} else {
+				// no spare voices left, hard steal...
+				if (pv->note1 >= 0)
+					m_note1[pv->note1] = nullptr;
+				if (pv->note2 >= 0)
+					m_note2[pv->note2] = nullptr;
+				free_voice(pv);
+			}
+		}
+
+		synthv1_voice *pv = m_voices.acquire();
 		if (pv) {
-			m_free_list.remove(pv);
-			m_play_list.append(pv);
 			++m_nvoices;
+			pv->note1 = pv->note2 = -1;
+			pv->key = key;
+			pv->ctlr.reset();
 		}
 		return pv;
 	}
 
+	synthv1_voice *steal_voice(int key);
+
 	void free_voice ( synthv1_voice *pv )
 	{
 		if (m_lfo1.psync == pv)
@@ -939,13 +1215,68 @@ protected:
 		if (m_lfo2.psync == pv)
 			m_lfo2.psync = nullptr;
 
-		m_play_list.remove(pv);
-		m_free_list.append(pv);
+		if (pv->stolen) {
+			pv->stolen = false;
+			--m_nstolen;
+		}
+
+		m_voices.release(pv);
 		--m_nvoices;
 	}
 
 	void alloc_sfxs(uint32_t nsize);
 
+	bool process_voice(synthv1_voice *pv,
+		float **outs, float **sfxs, uint32_t nframes);
+
+	// voice render kernels, specialized per oscillator interpolation,
+	// filter type (0 = disabled, 1 + slope) and LFO enablement...
+	typedef void (synthv1_impl::*RenderVoice)(synthv1_voice *pv,
+		float **v_outs, float **v_sfxs, uint32_t nframe, uint32_t ngen);
+
+	template <int INTERP, int DCF1, int DCF2, bool LFO1, bool LFO2>
+	void render_voice(synthv1_voice *pv,
+		float **v_outs, float **v_sfxs, uint32_t nframe, uint32_t ngen);
+
+#ifdef SYNTHV1_CPU_DISPATCH
+	template <int INTERP, int DCF1, int DCF2, bool LFO1, bool LFO2>
+	void render_voice_avx2(synthv1_voice *pv,
+		float **v_outs, float **v_sfxs, uint32_t nframe, uint32_t ngen);
+#endif
+
+	template <int LEVEL, uint32_t I>
+	static constexpr RenderVoice render_voice_entry();
+
+	template <int LEVEL, uint32_t... I>
+	static const RenderVoice *render_voice_table(
+		std::integer_sequence<uint32_t, I...>);
+
+	RenderVoice render_voice_func() const;
+
+	// whether all effects are off or their tails have decayed.
+	bool fx_dormant();
+
+	// number of (multichannel) compressors.
+	uint16_t comp_count() const
+		{ return (m_nchannels + synthv1_fx_comp::MAX_CHANNELS - 1)
+			/ synthv1_fx_comp::MAX_CHANNELS; }
+
+	// effects and output mix-down (per CPU level).
+	void process_fx_dispatch(float **outs, float **sfxs, uint32_t nframes);
+	void process_fx(float **outs, float **sfxs, uint32_t nframes);
+#ifdef SYNTHV1_CPU_DISPATCH
+	void process_fx_avx2(float **outs, float **sfxs, uint32_t nframes);
+	void process_fx_avx512(float **outs, float **sfxs, uint32_t nframes);
+#endif
+
+	// effects and output mix-down, pipelined (one period behind).
+	void process_fx_pipe(float **outs, uint32_t nframes);
+
+	void alloc_fx_pipe(uint32_t nframes);
+	void reset_fx_pipe();
+
+	void control_voice(synthv1_voice *pv, uint32_t nctl, uint32_t nframe);
+
 private:
 
 	synthv1_config   m_config;
@@ -970,6 +1301,20 @@ private:
 
 	synthv1_def m_def1, m_def2;
 
+	synthv1_snap m_snap1, m_snap2;
+
+	RenderVoice m_render_voice;
+
+	volatile uint16_t m_ctl_frames;
+	uint32_t m_nctl;
+
+	volatile int m_cpu_level;
+
+	volatile int m_interp;
+
+	volatile int m_over;
+	uint32_t m_nover;
+
 	synthv1_cho m_cho;
 	synthv1_fla m_fla;
 	synthv1_pha m_pha;
@@ -979,13 +1324,12 @@ private:
 
 	synthv1_key m_key;
 
-	synthv1_voice **m_voices;
+	synthv1_bank<synthv1_voice> m_voices;
+
+	uint16_t        m_polyphony;
 	synthv1_voice  *m_note1[MAX_NOTES];
 	synthv1_voice  *m_note2[MAX_NOTES];
 
-	synthv1_list<synthv1_voice> m_free_list;
-	synthv1_list<synthv1_voice> m_play_list;
-
 	synthv1_ramp1 m_wid1, m_wid2;
 	synthv1_bal2  m_pan1, m_pan2;
 	synthv1_ramp3 m_vol1, m_vol2;
@@ -993,6 +1337,17 @@ private:
 	float  **m_sfxs;
 	uint32_t m_nsize;
 
+	// parallel voice rendering (optional)
+	synthv1_pool     *m_pool;
+	synthv1_slice_job m_slice_job;
+
+	bool           *m_sfree;
+	uint32_t        m_nslist;
+	uint32_t        m_nslice;
+
+	float **m_souts;
+	float **m_ssfxs;
+
 	synthv1_fx_chorus   m_chorus;
 	synthv1_fx_flanger *m_flanger;
 	synthv1_fx_phaser  *m_phaser;
@@ -1001,6 +1356,20 @@ private:
 
 	synthv1_reverb m_reverb;
 
+	// pipelined effects chain (optional)
+	synthv1_pool  *m_fx_pool;
+	synthv1_fx_job m_fx_job;
+	uint32_t       m_fx_period;
+	uint32_t       m_fx_fill;
+	uint16_t       m_fx_cur;
+	bool           m_fx_busy;
+	volatile bool  m_fx_dormant;
+	uint16_t       m_fx_settle;
+	bool           m_fx_sleep;
+
+	float **m_fx_outs[2];
+	float **m_fx_sfxs[2];
+
 	// process direct note on/off...
 	volatile uint16_t m_direct_note;
 
@@ -1009,17 +1378,19 @@ private:
 	} m_direct_notes[MAX_DIRECT_NOTES];
 
 	volatile int  m_nvoices;
+	volatile int  m_nstolen;
+
+	synthv1::VoiceSteal m_steal;
 
 	volatile bool m_running;
+	volatile bool m_idle;
 };
 
 
 // voice constructor
 
 synthv1_voice::synthv1_voice ( synthv1_impl *pImpl ) :
-	note1(-1), note2(-1),
 	vel1(0.0f), vel2(0.0f),
-	pre1(0.0f), pre2(0.0f),
 	dco11(&pImpl->dco1_wave1),
 	dco12(&pImpl->dco1_wave2),
 	dco21(&pImpl->dco2_wave1),
@@ -1031,27 +1402,32 @@ synthv1_voice::synthv1_voice ( synthv1_impl *pImpl ) :
 	dco2_freq1(0.0f), dco2_sample1(0.0f),
 	dco2_freq2(0.0f), dco2_sample2(0.0f),
 	lfo1_sample(0.0f), lfo2_sample(0.0f),
-	dcf17(&pImpl->dcf1_formant),
-	dcf18(&pImpl->dcf1_formant),
-	dcf27(&pImpl->dcf2_formant),
-	dcf28(&pImpl->dcf2_formant),
+	out1_panning(0.0f), out2_panning(0.0f),
+	out1_volume(1.0f), out2_volume(1.0f),
 	dco1_glide1(pImpl->dco1_last1),
 	dco1_glide2(pImpl->dco1_last2),
 	dco2_glide1(pImpl->dco2_last1),
 	dco2_glide2(pImpl->dco2_last2),
-	out1_panning(0.0f), out2_panning(0.0f),
-	out1_volume(1.0f), out2_volume(1.0f),
-	sustain1(false), sustain2(false)
+	note1(-1), note2(-1), key(-1),
+	pre1(0.0f), pre2(0.0f),
+	sustain1(false), sustain2(false),
+	stolen(false),
+	dcf17(&pImpl->dcf1_formant),
+	dcf18(&pImpl->dcf1_formant),
+	dcf27(&pImpl->dcf2_formant),
+	dcf28(&pImpl->dcf2_formant)
 {
 }
 
 
 // engine constructor
 
-synthv1_impl::synthv1_impl (
-	synthv1 *pSynth, uint16_t nchannels, float srate, uint32_t nsize )
+synthv1_impl::synthv1_impl ( synthv1 *pSynth,
+	uint16_t nchannels, float srate, uint32_t nsize, uint16_t nvoices )
 	: m_controls(pSynth), m_programs(pSynth), m_midi_in(pSynth),
-		m_bpm(180.0f), m_nvoices(0), m_running(false)
+		m_bpm(180.0f), m_slice_job(this), m_fx_job(this),
+		m_nvoices(0), m_nstolen(0),
+		m_steal(synthv1::StealNone), m_running(false), m_idle(false)
 {
 	// max env. stage length (default)
 	m_dco1.envtime0 = m_dco2.envtime0 = 0.0001f * MAX_ENV_MSECS;
@@ -1062,13 +1438,21 @@ synthv1_impl::synthv1_impl (
 	dco2_last1 = 0.0f;
 	dco2_last2 = 0.0f;
 
-	// allocate voice pool.
-	m_voices = new synthv1_voice * [MAX_VOICES];
+	// polyphony (0 = default, as configured)
+	if (nvoices < 1)
+		nvoices = m_config.iPolyphony;
+	if (nvoices < 1)
+		nvoices = DEF_VOICES;
+	else
+	if (nvoices > MAX_VOICES)
+		nvoices = MAX_VOICES;
 
-	for (int i = 0; i < MAX_VOICES; ++i) {
-		m_voices[i] = new synthv1_voice(this);
-		m_free_list.append(m_voices[i]);
-	}
+	m_polyphony = nvoices;
+
+	// allocate voice pool (plus spares, for stealing).
+	const int nvoices_max = m_polyphony + STEAL_VOICES;
+
+	m_voices.alloc(nvoices_max, this);
 
 	for (int note = 0; note < MAX_NOTES; ++note)
 		m_note1[note] = m_note2[note] = nullptr;
@@ -1077,6 +1461,33 @@ synthv1_impl::synthv1_impl (
 	m_sfxs = nullptr;
 	m_nsize = 0;
 
+	// voice render kernel none yet
+	m_render_voice = nullptr;
+
+	// per sample modulation (default)
+	m_ctl_frames = 0;
+	m_nctl = 0;
+
+	// generic DSP kernels (default)
+	m_cpu_level = synthv1::CpuGeneric;
+
+	// linear oscillator interpolation (default)
+	m_interp = synthv1::InterpLinear;
+
+	// no voice oversampling (default)
+	m_over = synthv1::Oversample1x;
+	m_nover = 1;
+
+	// parallel voice slices none yet
+	m_pool = nullptr;
+
+	m_sfree = new bool [nvoices_max];
+	m_nslist = 0;
+	m_nslice = 0;
+
+	m_souts = nullptr;
+	m_ssfxs = nullptr;
+
 	// flangers none yet
 	m_flanger = nullptr;
 
@@ -1089,6 +1500,19 @@ synthv1_impl::synthv1_impl (
 	// compressors none yet
 	m_comp = nullptr;
 
+	// pipelined effects none yet
+	m_fx_pool = nullptr;
+	m_fx_period = 0;
+	m_fx_fill = 0;
+	m_fx_cur = 0;
+	m_fx_busy = false;
+	m_fx_dormant = false;
+	m_fx_settle = 0;
+	m_fx_sleep = false;
+
+	m_fx_outs[0] = m_fx_outs[1] = nullptr;
+	m_fx_sfxs[0] = m_fx_sfxs[1] = nullptr;
+
 	// Micro-tuning support, if any...
 	resetTuning();
 
@@ -1105,6 +1529,30 @@ synthv1_impl::synthv1_impl (
 	// set default buffer size
 	setBufferSize(nsize);
 
+	// parallel voice rendering, if any...
+	setVoiceThreads(m_config.iVoiceThreads);
+
+	// voice stealing policy, if any...
+	setVoiceSteal(synthv1::VoiceSteal(m_config.iVoiceSteal));
+
+	// control-rate modulation, if any...
+	setControlRate(m_config.iControlRate);
+
+	// DSP kernels instruction set level (auto-detect).
+	setCpuLevel(synthv1::CpuLevel(m_config.iCpuLevel));
+
+	// oscillator interpolation quality.
+	setInterpolation(synthv1::Interp(m_config.iInterpolation));
+
+	// voice oversampling.
+	setOversampling(synthv1::Oversample(m_config.iOversampling));
+
+	// oscillator width morphing, if any...
+	setWidthMorph(m_config.bWidthMorph);
+
+	// pipelined effects chain, if any (one buffer period)...
+	setFxPipeline(m_config.bFxPipeline ? m_nsize : 0);
+
 	// reset all voices
 	allControllersOff();
 	allNotesOff();
@@ -1123,11 +1571,16 @@ synthv1_impl::~synthv1_impl (void)
 	m_config.savePrograms(&m_programs);
 #endif
 
-	// deallocate voice pool.
-	for (int i = 0; i < MAX_VOICES; ++i)
-		delete m_voices[i];
+	// deallocate parallel voice rendering
+	setVoiceThreads(0);
+
+	// deallocate pipelined effects
+	setFxPipeline(0);
 
-	delete [] m_voices;
+	delete [] m_sfree;
+
+	// deallocate voice pool.
+	m_voices.clear();
 
 	// deallocate local buffers
 	alloc_sfxs(0);
@@ -1184,8 +1637,8 @@ void synthv1_impl::setSampleRate ( float srate )
 	dco2_wave1.setSampleRate(m_srate);
 	dco2_wave2.setSampleRate(m_srate);
 
-	dcf1_formant.setSampleRate(m_srate);
-	dcf2_formant.setSampleRate(m_srate);
+	dcf1_formant.setSampleRate(m_srate * float(m_nover));
+	dcf2_formant.setSampleRate(m_srate * float(m_nover));
 
 	lfo1_wave.setSampleRate(m_srate);
 	lfo2_wave.setSampleRate(m_srate);
@@ -1226,6 +1679,12 @@ float synthv1_impl::tempo (void) const
 }
 
 
+uint16_t synthv1_impl::polyphony (void) const
+{
+	return m_polyphony;
+}
+
+
 // allocate local buffers
 void synthv1_impl::alloc_sfxs ( uint32_t nsize )
 {
@@ -1237,93 +1696,400 @@ void synthv1_impl::alloc_sfxs ( uint32_t nsize )
 		m_nsize = 0;
 	}
 
+	if (m_souts) {
+		const uint32_t nbufs = MAX_SLICES * m_nchannels;
+		for (uint32_t i = 0; i < nbufs; ++i) {
+			delete [] m_ssfxs[i];
+			delete [] m_souts[i];
+		}
+		delete [] m_ssfxs;
+		delete [] m_souts;
+		m_ssfxs = nullptr;
+		m_souts = nullptr;
+	}
+
 	if (m_nsize < nsize) {
 		m_nsize = nsize;
 		m_sfxs = new float * [m_nchannels];
 		for (uint16_t k = 0; k < m_nchannels; ++k)
 			m_sfxs[k] = new float [m_nsize];
+		if (m_pool) {
+			const uint32_t nbufs = MAX_SLICES * m_nchannels;
+			m_souts = new float * [nbufs];
+			m_ssfxs = new float * [nbufs];
+			for (uint32_t i = 0; i < nbufs; ++i) {
+				m_souts[i] = new float [m_nsize];
+				m_ssfxs[i] = new float [m_nsize];
+			}
+		}
 	}
 }
 
 
-void synthv1_impl::updateEnvTimes_1 (void)
-{
-	// update envelope range times in frames
-	const float srate_ms = 0.001f * m_srate;
-
-	float envtime_msecs = 10000.0f * m_dco1.envtime0;
-	if (envtime_msecs < MIN_ENV_MSECS)
-		envtime_msecs = MIN_ENV_MSECS * 4.0f;
-
-	const uint32_t min_frames1 = uint32_t(srate_ms * MIN_ENV_MSECS);
-	const uint32_t min_frames2 = (min_frames1 << 2);
-	const uint32_t max_frames  = uint32_t(srate_ms * envtime_msecs);
+// parallel voice rendering (0 = none, serial)
 
-	m_dcf1.env.min_frames1 = min_frames1;
-	m_dcf1.env.min_frames2 = min_frames2;
-	m_dcf1.env.max_frames  = max_frames;
+void synthv1_impl::setVoiceThreads ( uint16_t nthreads )
+{
+	if (m_pool) {
+		delete m_pool;
+		m_pool = nullptr;
+	}
 
-	m_lfo1.env.min_frames1 = min_frames1;
-	m_lfo1.env.min_frames2 = min_frames2;
-	m_lfo1.env.max_frames  = max_frames;
+	if (nthreads > 0)
+		m_pool = new synthv1_pool(nthreads - 1);
 
-	m_dca1.env.min_frames1 = min_frames1;
-	m_dca1.env.min_frames2 = min_frames2;
-	m_dca1.env.max_frames  = max_frames;
+	// (re)allocate slice buffers...
+	const uint32_t nsize = m_nsize;
+	alloc_sfxs(0);
+	alloc_sfxs(nsize);
 }
 
 
-void synthv1_impl::updateEnvTimes_2 (void)
+uint16_t synthv1_impl::voiceThreads (void) const
 {
-	// update envelope range times in frames
-	const float srate_ms = 0.001f * m_srate;
+	return (m_pool ? m_pool->count() : 0);
+}
 
-	float envtime_msecs = 10000.0f * m_dco2.envtime0;
-	if (envtime_msecs < MIN_ENV_MSECS)
-		envtime_msecs = MIN_ENV_MSECS * 4.0f;
 
-	const uint32_t min_frames1 = uint32_t(srate_ms * MIN_ENV_MSECS);
-	const uint32_t min_frames2 = (min_frames1 << 2);
-	const uint32_t max_frames  = uint32_t(srate_ms * envtime_msecs);
+// pipelined effects chain (0 = none, serial; otherwise period in frames)
 
-	m_dcf2.env.min_frames1 = min_frames1;
-	m_dcf2.env.min_frames2 = min_frames2;
-	m_dcf2.env.max_frames  = max_frames;
+void synthv1_impl::setFxPipeline ( uint32_t nframes )
+{
+	if (m_fx_pool) {
+		if (m_fx_busy) {
+			m_fx_pool->wait();
+			m_fx_busy = false;
+		}
+		delete m_fx_pool;
+		m_fx_pool = nullptr;
+	}
 
-	m_lfo2.env.min_frames1 = min_frames1;
-	m_lfo2.env.min_frames2 = min_frames2;
-	m_lfo2.env.max_frames  = max_frames;
+	alloc_fx_pipe(0);
 
-	m_dca2.env.min_frames1 = min_frames1;
-	m_dca2.env.min_frames2 = min_frames2;
-	m_dca2.env.max_frames  = max_frames;
+	if (nframes > 0) {
+		m_fx_pool = new synthv1_pool(1);
+		alloc_fx_pipe(nframes);
+	}
 }
 
 
-void synthv1_impl::updateEnvTimes (void)
+uint32_t synthv1_impl::fxPipeline (void) const
 {
-	updateEnvTimes_1();
-	updateEnvTimes_2();
+	return m_fx_period;
 }
 
 
-void synthv1_impl::setParamPort ( synthv1::ParamIndex index, float *pfParam )
+// processing latency (frames)
+
+uint32_t synthv1_impl::latency (void) const
 {
-	static float s_fDummy = 0.0f;
+	return m_fx_period;
+}
 
-	if (pfParam == nullptr)
-		pfParam = &s_fDummy;
 
-	synthv1_port *pParamPort = paramPort(index);
-	if (pParamPort)
-		pParamPort->set_port(pfParam);
+// allocate pipelined effects buffers (two periods, zeroed)
 
-	// check null connections.
-	if (pfParam == &s_fDummy)
-		return;
+void synthv1_impl::alloc_fx_pipe ( uint32_t nframes )
+{
+	uint16_t j, k;
 
-	// reset ramps after port (re)connection.
-	switch (index) {
+	for (j = 0; j < 2; ++j) {
+		if (m_fx_outs[j]) {
+			for (k = 0; k < m_nchannels; ++k) {
+				delete [] m_fx_sfxs[j][k];
+				delete [] m_fx_outs[j][k];
+			}
+			delete [] m_fx_sfxs[j];
+			delete [] m_fx_outs[j];
+			m_fx_sfxs[j] = nullptr;
+			m_fx_outs[j] = nullptr;
+		}
+	}
+
+	m_fx_period = 0;
+	m_fx_fill = 0;
+	m_fx_cur = 0;
+	m_fx_dormant = false;
+	m_fx_settle = 0;
+	m_fx_sleep = false;
+
+	if (nframes > 0) {
+		m_fx_period = nframes;
+		for (j = 0; j < 2; ++j) {
+			m_fx_outs[j] = new float * [m_nchannels];
+			m_fx_sfxs[j] = new float * [m_nchannels];
+			for (k = 0; k < m_nchannels; ++k) {
+				m_fx_outs[j][k] = new float [nframes];
+				m_fx_sfxs[j][k] = new float [nframes];
+				::memset(m_fx_outs[j][k], 0, nframes * sizeof(float));
+				::memset(m_fx_sfxs[j][k], 0, nframes * sizeof(float));
+			}
+		}
+	}
+}
+
+
+// reset pipelined effects buffers (helper thread done, both periods zeroed)
+
+void synthv1_impl::reset_fx_pipe (void)
+{
+	if (m_fx_busy) {
+		m_fx_pool->wait();
+		m_fx_busy = false;
+	}
+
+	for (uint16_t j = 0; j < 2; ++j) {
+		if (m_fx_outs[j] == nullptr)
+			continue;
+		for (uint16_t k = 0; k < m_nchannels; ++k) {
+			::memset(m_fx_outs[j][k], 0, m_fx_period * sizeof(float));
+			::memset(m_fx_sfxs[j][k], 0, m_fx_period * sizeof(float));
+		}
+	}
+}
+
+
+// voice stealing policy (when polyphony is exhausted)
+
+void synthv1_impl::setVoiceSteal ( synthv1::VoiceSteal steal )
+{
+	if (steal < synthv1::StealNone || steal > synthv1::StealSameNote)
+		steal = synthv1::StealNone;
+
+	m_steal = steal;
+}
+
+
+synthv1::VoiceSteal synthv1_impl::voiceSteal (void) const
+{
+	return m_steal;
+}
+
+
+// control-rate modulation period (0 = none, per sample)
+
+void synthv1_impl::setControlRate ( uint16_t nframes )
+{
+	if (nframes < 2)
+		nframes = 0;
+	else
+	if (nframes > MAX_CTL_FRAMES)
+		nframes = MAX_CTL_FRAMES;
+
+	m_ctl_frames = nframes;
+}
+
+
+uint16_t synthv1_impl::controlRate (void) const
+{
+	return m_ctl_frames;
+}
+
+
+// DSP kernels instruction set level (runtime CPU dispatch)
+
+void synthv1_impl::setCpuLevel ( synthv1::CpuLevel level )
+{
+	m_cpu_level = synthv1_cpu_level(level);
+}
+
+
+synthv1::CpuLevel synthv1_impl::cpuLevel (void) const
+{
+	return synthv1::CpuLevel(m_cpu_level);
+}
+
+
+// oscillator wave table interpolation quality
+
+void synthv1_impl::setInterpolation ( synthv1::Interp interp )
+{
+	if (interp < synthv1::InterpLinear || interp > synthv1::InterpDraft)
+		interp = synthv1::InterpLinear;
+
+	m_interp = interp;
+}
+
+
+synthv1::Interp synthv1_impl::interpolation (void) const
+{
+	return synthv1::Interp(m_interp);
+}
+
+
+// voice oscillators and filters oversampling
+
+void synthv1_impl::setOversampling ( synthv1::Oversample over )
+{
+	if (over < synthv1::Oversample1x || over > synthv1::Oversample4x)
+		over = synthv1::Oversample1x;
+
+	m_over = over;
+}
+
+
+synthv1::Oversample synthv1_impl::oversampling (void) const
+{
+	return synthv1::Oversample(m_over);
+}
+
+
+// oscillator width morphing (precomputed width table banks)
+
+void synthv1_impl::setWidthMorph ( bool wmorph )
+{
+	dco1_wave1.setWidthMorph(wmorph);
+	dco1_wave2.setWidthMorph(wmorph);
+	dco2_wave1.setWidthMorph(wmorph);
+	dco2_wave2.setWidthMorph(wmorph);
+}
+
+
+bool synthv1_impl::isWidthMorph (void) const
+{
+	return dco1_wave1.isWidthMorph();
+}
+
+
+// pick a playing voice to steal, as of current policy
+// (play list is in note-on order, oldest first)
+
+synthv1_voice *synthv1_impl::steal_voice ( int key )
+{
+	if (m_steal == synthv1::StealNone)
+		return nullptr;
+
+	synthv1_voice *pv_steal = nullptr;
+	float value_min = 0.0f;
+
+	for (uint16_t i = 0; i < m_voices.count(); ++i) {
+		synthv1_voice *pv = m_voices.at(i);
+		if (pv->stolen) // already fading out
+			continue;
+		if (m_steal == synthv1::StealQuietest) {
+			const float value = (pv->dca1_env.value > pv->dca2_env.value
+				? pv->dca1_env.value : pv->dca2_env.value);
+			if (pv_steal == nullptr || value_min > value) {
+				value_min = value;
+				pv_steal = pv;
+			}
+		}
+		else
+		if (m_steal == synthv1::StealReleased) {
+			if (pv->note1 < 0 && pv->note2 < 0)
+				return pv;
+			if (pv_steal == nullptr)
+				pv_steal = pv;
+		}
+		else
+		if (m_steal == synthv1::StealSameNote) {
+			if (pv->key == key)
+				return pv;
+			if (pv_steal == nullptr)
+				pv_steal = pv;
+		}
+		else // StealOldest
+			return pv;
+	}
+
+	return pv_steal;
+}
+
+
+// voice slice rendering job (parallel)
+
+void synthv1_slice_job::process ( uint32_t islice )
+{
+	m_pImpl->process_slice(islice);
+}
+
+
+// effects chain job (pipelined)
+
+void synthv1_fx_job::process ( uint32_t /*islice*/ )
+{
+	m_pImpl->process_fx_job();
+}
+
+
+void synthv1_impl::updateEnvTimes_1 (void)
+{
+	// update envelope range times in frames
+	const float srate_ms = 0.001f * m_srate;
+
+	float envtime_msecs = 10000.0f * m_dco1.envtime0;
+	if (envtime_msecs < MIN_ENV_MSECS)
+		envtime_msecs = MIN_ENV_MSECS * 4.0f;
+
+	const uint32_t min_frames1 = uint32_t(srate_ms * MIN_ENV_MSECS);
+	const uint32_t min_frames2 = (min_frames1 << 2);
+	const uint32_t max_frames  = uint32_t(srate_ms * envtime_msecs);
+
+	m_dcf1.env.min_frames1 = min_frames1;
+	m_dcf1.env.min_frames2 = min_frames2;
+	m_dcf1.env.max_frames  = max_frames;
+
+	m_lfo1.env.min_frames1 = min_frames1;
+	m_lfo1.env.min_frames2 = min_frames2;
+	m_lfo1.env.max_frames  = max_frames;
+
+	m_dca1.env.min_frames1 = min_frames1;
+	m_dca1.env.min_frames2 = min_frames2;
+	m_dca1.env.max_frames  = max_frames;
+}
+
+
+void synthv1_impl::updateEnvTimes_2 (void)
+{
+	// update envelope range times in frames
+	const float srate_ms = 0.001f * m_srate;
+
+	float envtime_msecs = 10000.0f * m_dco2.envtime0;
+	if (envtime_msecs < MIN_ENV_MSECS)
+		envtime_msecs = MIN_ENV_MSECS * 4.0f;
+
+	const uint32_t min_frames1 = uint32_t(srate_ms * MIN_ENV_MSECS);
+	const uint32_t min_frames2 = (min_frames1 << 2);
+	const uint32_t max_frames  = uint32_t(srate_ms * envtime_msecs);
+
+	m_dcf2.env.min_frames1 = min_frames1;
+	m_dcf2.env.min_frames2 = min_frames2;
+	m_dcf2.env.max_frames  = max_frames;
+
+	m_lfo2.env.min_frames1 = min_frames1;
+	m_lfo2.env.min_frames2 = min_frames2;
+	m_lfo2.env.max_frames  = max_frames;
+
+	m_dca2.env.min_frames1 = min_frames1;
+	m_dca2.env.min_frames2 = min_frames2;
+	m_dca2.env.max_frames  = max_frames;
+}
+
+
+void synthv1_impl::updateEnvTimes (void)
+{
+	updateEnvTimes_1();
+	updateEnvTimes_2();
+}
+
+
+void synthv1_impl::setParamPort ( synthv1::ParamIndex index, float *pfParam )
+{
+	static float s_fDummy = 0.0f;
+
+	if (pfParam == nullptr)
+		pfParam = &s_fDummy;
+
+	synthv1_port *pParamPort = paramPort(index);
+	if (pParamPort)
+		pParamPort->set_port(pfParam);
+
+	// check null connections.
+	if (pfParam == &s_fDummy)
+		return;
+
+	// reset ramps after port (re)connection.
+	switch (index) {
 	case synthv1::OUT1_VOLUME:
 	case synthv1::DCA1_VOLUME:
 		m_vol1.reset(
@@ -1512,6 +2278,8 @@ synthv1_port *synthv1_impl::paramPort ( synthv1::ParamIndex index )
 	case synthv1::DYN1_LIMITER:   pParamPort = &m_dyn.limiter;      break;
 	case synthv1::KEY1_LOW:       pParamPort = &m_key.low;          break;
 	case synthv1::KEY1_HIGH:      pParamPort = &m_key.high;         break;
+	case synthv1::DCO1_POLYBLEP:  pParamPort = &m_dco1.polyblep;    break;
+	case synthv1::DCO2_POLYBLEP:  pParamPort = &m_dco2.polyblep;    break;
 	default: break;
 	}
 
@@ -1598,7 +2366,8 @@ void synthv1_impl::process_midi ( uint8_t *data, uint32_t size )
 				// mono voice modes
 				if (*m_def1.mono > 0.0f) {
 					int n1 = 0;
-					for (pv = m_play_list.next(); pv; pv = pv->next()) {
+					for (uint16_t j = 0; j < m_voices.count(); ++j) {
+						pv = m_voices.at(j);
 						if (pv->note1 >= 0
 							&& pv->dca1_env.stage != synthv1_env::Release) {
 							m_dcf1.env.note_off_fast(&pv->dcf1_env);
@@ -1627,7 +2396,8 @@ void synthv1_impl::process_midi ( uint8_t *data, uint32_t size )
 				// mono voice modes
 				if (*m_def2.mono > 0.0f) {
 					int n2 = 0;
-					for (pv = m_play_list.next(); pv; pv = pv->next()) {
+					for (uint16_t j = 0; j < m_voices.count(); ++j) {
+						pv = m_voices.at(j);
 						if (pv->note2 >= 0
 							&& pv->dca2_env.stage != synthv1_env::Release) {
 							m_dcf2.env.note_off_fast(&pv->dcf2_env);
@@ -1651,8 +2421,8 @@ void synthv1_impl::process_midi ( uint8_t *data, uint32_t size )
 					pv->note2 = -1;
 				}
 			}
-			// find free voice
-			pv = alloc_voice();
+			// find free voice (or steal one)
+			pv = alloc_voice(key);
 			if (pv) {
 				// velocity (quadratic velocity law)
 				float vel = float(value) / 127.0f; vel *= vel;
@@ -1698,12 +2468,16 @@ void synthv1_impl::process_midi ( uint8_t *data, uint32_t size )
 					pv->dco1_sample2 = pv->dco12.start(dco1_phase, pv->dco1_freq2);
 					// filters
 					const int dcf1_type = int(*m_dcf1.type);
-					pv->dcf11.reset(synthv1_filter1::Type(dcf1_type));
-					pv->dcf12.reset(synthv1_filter1::Type(dcf1_type));
-					pv->dcf13.reset(synthv1_filter2::Type(dcf1_type));
-					pv->dcf14.reset(synthv1_filter2::Type(dcf1_type));
-					pv->dcf15.reset(synthv1_filter3::Type(dcf1_type));
-					pv->dcf16.reset(synthv1_filter3::Type(dcf1_type));
+					pv->dcfq1.reset(0, synthv1_filter1::Type(dcf1_type));
+					pv->dcfq1.reset(1, synthv1_filter1::Type(dcf1_type));
+					pv->dcfq2.reset(0, synthv1_filter2::Type(dcf1_type));
+					pv->dcfq2.reset(1, synthv1_filter2::Type(dcf1_type));
+					pv->dcfq3.reset(0, synthv1_filter3::Type(dcf1_type));
+					pv->dcfq3.reset(1, synthv1_filter3::Type(dcf1_type));
+					pv->over42.reset(0);
+					pv->over42.reset(1);
+					pv->over21.reset(0);
+					pv->over21.reset(1);
 					// formant filters
 					const float dcf1_cutoff = *m_dcf1.cutoff;
 					const float dcf1_reso = *m_dcf1.reso;
@@ -1777,12 +2551,16 @@ void synthv1_impl::process_midi ( uint8_t *data, uint32_t size )
 					pv->dco2_sample2 = pv->dco22.start(dco2_phase, pv->dco2_freq2);
 					// filters
 					const int dcf2_type = int(*m_dcf2.type);
-					pv->dcf21.reset(synthv1_filter1::Type(dcf2_type));
-					pv->dcf22.reset(synthv1_filter1::Type(dcf2_type));
-					pv->dcf23.reset(synthv1_filter2::Type(dcf2_type));
-					pv->dcf24.reset(synthv1_filter2::Type(dcf2_type));
-					pv->dcf25.reset(synthv1_filter3::Type(dcf2_type));
-					pv->dcf26.reset(synthv1_filter3::Type(dcf2_type));
+					pv->dcfq1.reset(2, synthv1_filter1::Type(dcf2_type));
+					pv->dcfq1.reset(3, synthv1_filter1::Type(dcf2_type));
+					pv->dcfq2.reset(2, synthv1_filter2::Type(dcf2_type));
+					pv->dcfq2.reset(3, synthv1_filter2::Type(dcf2_type));
+					pv->dcfq3.reset(2, synthv1_filter3::Type(dcf2_type));
+					pv->dcfq3.reset(3, synthv1_filter3::Type(dcf2_type));
+					pv->over42.reset(2);
+					pv->over42.reset(3);
+					pv->over21.reset(2);
+					pv->over21.reset(3);
 					// formant filters
 					const float dcf2_cutoff = *m_dcf2.cutoff;
 					const float dcf2_reso = *m_dcf2.reso;
@@ -1839,7 +2617,7 @@ void synthv1_impl::process_midi ( uint8_t *data, uint32_t size )
 						pv->note1 = -1;
 						// mono legato?
 						if (*m_def1.mono > 0.0f) {
-							do pv = pv->prev();	while (pv && pv->note1 < 0);
+							do pv = m_voices.prev(pv); while (pv && pv->note1 < 0);
 							if (pv && pv->note1 >= 0) {
 								const bool legato1 = (*m_def1.mono > 1.0f);
 								m_dcf1.env.restart(&pv->dcf1_env, legato1);
@@ -1868,7 +2646,7 @@ void synthv1_impl::process_midi ( uint8_t *data, uint32_t size )
 						pv->note2 = -1;
 						// mono legato?
 						if (*m_def2.mono > 0.0f) {
-							do pv = pv->prev();	while (pv && pv->note2 < 0);
+							do pv = m_voices.prev(pv); while (pv && pv->note2 < 0);
 							if (pv && pv->note2 >= 0) {
 								const bool legato2 = (*m_def2.mono > 1.0f);
 								m_dcf2.env.restart(&pv->dcf2_env, legato2);
@@ -1999,17 +2777,23 @@ void synthv1_impl::process_midi ( uint8_t *data, uint32_t size )
 
 void synthv1_impl::allSoundOff (void)
 {
+	// effects may well be busy on the helper thread...
+	reset_fx_pipe();
+
 	m_chorus.setSampleRate(m_srate);
 	m_chorus.reset();
 
 	for (uint16_t k = 0; k < m_nchannels; ++k) {
 		m_phaser[k].setSampleRate(m_srate);
 		m_delay[k].setSampleRate(m_srate);
-		m_comp[k].setSampleRate(m_srate);
 		m_flanger[k].reset();
 		m_phaser[k].reset();
 		m_delay[k].reset();
-		m_comp[k].reset();
+	}
+
+	for (uint16_t j = 0; j < comp_count(); ++j) {
+		m_comp[j].setSampleRate(m_srate);
+		m_comp[j].reset();
 	}
 
 	m_reverb.setSampleRate(m_srate);
@@ -2040,14 +2824,13 @@ void synthv1_impl::allControllersOff_2 (void)
 
 void synthv1_impl::allNotesOff (void)
 {
-	synthv1_voice *pv = m_play_list.next();
-	while (pv) {
+	while (m_voices.count() > 0) {
+		synthv1_voice *pv = m_voices.at(0);
 		if (pv->note1 >= 0)
 			m_note1[pv->note1] = nullptr;
 		if (pv->note2 >= 0)
 			m_note2[pv->note2] = nullptr;
 		free_voice(pv);
-		pv = m_play_list.next();
 	}
 
 	dco1_last1 = 0.0f;
@@ -2063,8 +2846,8 @@ void synthv1_impl::allNotesOff (void)
 
 void synthv1_impl::allNotesOff_1 (void)
 {
-	synthv1_voice *pv = m_play_list.next();
-	while (pv) {
+	for (uint16_t i = 0; i < m_voices.count(); ++i) {
+		synthv1_voice *pv = m_voices.at(i);
 		if (pv->note1 >= 0) {
 			m_dca1.env.note_off_fast(&pv->dca1_env);
 			m_dcf1.env.note_off_fast(&pv->dcf1_env);
@@ -2072,7 +2855,6 @@ void synthv1_impl::allNotesOff_1 (void)
 			m_note1[pv->note1] = nullptr;
 			pv->note1 = -1;
 		}
-		pv = pv->next();
 	}
 
 	dco1_last1 = 0.0f;
@@ -2082,8 +2864,8 @@ void synthv1_impl::allNotesOff_1 (void)
 
 void synthv1_impl::allNotesOff_2 (void)
 {
-	synthv1_voice *pv = m_play_list.next();
-	while (pv) {
+	for (uint16_t i = 0; i < m_voices.count(); ++i) {
+		synthv1_voice *pv = m_voices.at(i);
 		if (pv->note2 >= 0) {
 			m_dca2.env.note_off_fast(&pv->dca2_env);
 			m_dcf2.env.note_off_fast(&pv->dcf2_env);
@@ -2091,7 +2873,6 @@ void synthv1_impl::allNotesOff_2 (void)
 			m_note2[pv->note2] = nullptr;
 			pv->note2 = -1;
 		}
-		pv = pv->next();
 	}
 
 	dco2_last1 = 0.0f;
@@ -2103,8 +2884,8 @@ void synthv1_impl::allNotesOff_2 (void)
 
 void synthv1_impl::allSustainOff_1 (void)
 {
-	synthv1_voice *pv = m_play_list.next();
-	while (pv) {
+	for (uint16_t i = 0; i < m_voices.count(); ++i) {
+		synthv1_voice *pv = m_voices.at(i);
 		if (pv->note1 >= 0 && pv->sustain1) {
 			pv->sustain1 = false;
 			if (pv->dca1_env.stage != synthv1_env::Release) {
@@ -2115,15 +2896,14 @@ void synthv1_impl::allSustainOff_1 (void)
 				pv->note1 = -1;
 			}
 		}
-		pv = pv->next();
 	}
 }
 
 
 void synthv1_impl::allSustainOff_2 (void)
 {
-	synthv1_voice *pv = m_play_list.next();
-	while (pv) {
+	for (uint16_t i = 0; i < m_voices.count(); ++i) {
+		synthv1_voice *pv = m_voices.at(i);
 		if (pv->note2 >= 0 && pv->sustain2) {
 			pv->sustain2 = false;
 			if (pv->dca2_env.stage != synthv1_env::Release) {
@@ -2134,7 +2914,6 @@ void synthv1_impl::allSustainOff_2 (void)
 				pv->note2 = -1;
 			}
 		}
-		pv = pv->next();
 	}
 }
 
@@ -2143,22 +2922,20 @@ void synthv1_impl::allSustainOff_2 (void)
 
 void synthv1_impl::allSustainOn_1 (void)
 {
-	synthv1_voice *pv = m_play_list.next();
-	while (pv) {
+	for (uint16_t i = 0; i < m_voices.count(); ++i) {
+		synthv1_voice *pv = m_voices.at(i);
 		if (pv->note1 >= 0 && !pv->sustain1)
 			pv->sustain1 = true;
-		pv = pv->next();
 	}
 }
 
 
 void synthv1_impl::allSustainOn_2 (void)
 {
-	synthv1_voice *pv = m_play_list.next();
-	while (pv) {
+	for (uint16_t i = 0; i < m_voices.count(); ++i) {
+		synthv1_voice *pv = m_voices.at(i);
 		if (pv->note2 >= 0 && !pv->sustain2)
 			pv->sustain2 = true;
-		pv = pv->next();
 	}
 }
 
@@ -2342,9 +3119,9 @@ void synthv1_impl::reset (void)
 	if (m_delay == nullptr)
 		m_delay = new synthv1_fx_delay [m_nchannels];
 
-	// compressors
+	// compressors (multichannel)
 	if (m_comp == nullptr)
-		m_comp = new synthv1_fx_comp [m_nchannels];
+		m_comp = new synthv1_fx_comp [comp_count()];
 
 	// reverbs
 	m_reverb.reset();
@@ -2377,19 +3154,11 @@ void synthv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 {
 	if (!m_running) return;
 
-	float *v_outs[m_nchannels];
-	float *v_sfxs[m_nchannels];
-
 	// FIXME: fx-send buffer reallocation... seriously?
 	if (m_nsize < nframes) alloc_sfxs(nframes);
 
 	uint16_t k;
 
-	for (k = 0; k < m_nchannels; ++k) {
-		::memset(m_sfxs[k], 0, nframes * sizeof(float));
-		::memcpy(outs[k], ins[k], nframes * sizeof(float));
-	}
-
 	// process direct note on/off...
 	while (m_direct_note > 0) {
 		const direct_note& data
@@ -2397,26 +3166,87 @@ void synthv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 		process_midi((uint8_t *) &data, sizeof(data));
 	}
 
-	// controls
-
-	const bool lfo1_enabled = (*m_lfo1.enabled > 0.0f);
-	const bool lfo2_enabled = (*m_lfo2.enabled > 0.0f);
-
-	const float lfo1_freq = (lfo1_enabled
-		? get_bpm(*m_lfo1.bpm) / (60.01f - *m_lfo1.rate * 60.0f) : 0.0f);
-	const float lfo2_freq = (lfo2_enabled
-		? get_bpm(*m_lfo2.bpm) / (60.01f - *m_lfo2.rate * 60.0f) : 0.0f);
+	// idle? no voices playing and effects tails decayed: input
+	// passthrough only, while controls below still keep up.
+	// (any note-on wakes up, from the very next block segment)
+	bool fx_pipe = (m_fx_period > 0);
+
+	m_idle = (m_voices.count() < 1
+		&& (fx_pipe ? bool(m_fx_dormant) : fx_dormant()));
+
+	// pipelined effects: idle for a couple of whole periods, the pipe
+	// goes asleep, on a period boundary (no more helper wake-ups); it
+	// resumes from silence on the very next non-idle block.
+	if (fx_pipe) {
+		if (!m_idle) {
+			if (m_fx_sleep) {
+				reset_fx_pipe();
+				m_fx_sleep = false;
+			}
+			m_fx_settle = 0;
+		}
+		else
+		if (m_fx_settle > 1 && m_fx_fill == 0)
+			m_fx_sleep = true;
+		fx_pipe = !m_fx_sleep;
+	}
 
-	const float modwheel1 = (lfo1_enabled
-		? m_ctl1.modwheel + PITCH_SCALE * *m_lfo1.pitch : 0.0f);
-	const float modwheel2 = (lfo2_enabled
-		? m_ctl2.modwheel + PITCH_SCALE * *m_lfo2.pitch : 0.0f);
+	for (k = 0; k < m_nchannels; ++k) {
+		if (!m_idle || fx_pipe)
+			::memset(m_sfxs[k], 0, nframes * sizeof(float));
+		if (outs[k] != ins[k])
+			::memcpy(outs[k], ins[k], nframes * sizeof(float));
+	}
 
-	const bool dcf1_enabled = (*m_dcf1.enabled > 0.0f);
-	const bool dcf2_enabled = (*m_dcf2.enabled > 0.0f);
+	// controls (block parameter snapshot)
+
+	m_snap1.update(m_dco1, m_dcf1, m_lfo1, m_out1, nframes);
+	m_snap2.update(m_dco2, m_dcf2, m_lfo2, m_out2, nframes);
+
+	const bool lfo1_enabled = m_snap1.lfo_enabled;
+	const bool lfo2_enabled = m_snap2.lfo_enabled;
+
+	m_snap1.lfo_freq = (lfo1_enabled ? get_bpm(m_snap1.lfo_bpm)
+		/ (60.01f - m_snap1.lfo_rate * 60.0f) : 0.0f);
+	m_snap2.lfo_freq = (lfo2_enabled ? get_bpm(m_snap2.lfo_bpm)
+		/ (60.01f - m_snap2.lfo_rate * 60.0f) : 0.0f);
+
+	m_snap1.modwheel = (lfo1_enabled
+		? m_ctl1.modwheel + PITCH_SCALE * m_snap1.lfo_pitch : 0.0f);
+	m_snap2.modwheel = (lfo2_enabled
+		? m_ctl2.modwheel + PITCH_SCALE * m_snap2.lfo_pitch : 0.0f);
+
+	m_render_voice = render_voice_func();
+
+	// voice oversampling changed?
+	const uint32_t nover = (1 << m_over);
+	if (m_nover != nover) {
+		m_nover  = nover;
+		// formant filters run oversampled too...
+		dcf1_formant.setSampleRate(m_srate * float(m_nover));
+		dcf2_formant.setSampleRate(m_srate * float(m_nover));
+		for (uint16_t i = 0; i < m_voices.count(); ++i) {
+			synthv1_voice *pv = m_voices.at(i);
+			pv->dcf17.reset(&dcf1_formant);
+			pv->dcf18.reset(&dcf1_formant);
+			pv->dcf27.reset(&dcf2_formant);
+			pv->dcf28.reset(&dcf2_formant);
+			for (uint16_t k = 0; k < 4; ++k) {
+				pv->over42.reset(k);
+				pv->over21.reset(k);
+			}
+		}
+	}
 
-	const float fxsend1 = *m_out1.fxsend * *m_out1.fxsend;
-	const float fxsend2 = *m_out2.fxsend * *m_out2.fxsend;
+	// control-rate modulation period changed?
+	const uint32_t nctl = m_ctl_frames;
+	if (m_nctl != nctl) {
+		m_nctl  = nctl;
+		for (uint16_t i = 0; i < m_voices.count(); ++i) {
+			synthv1_voice *pv = m_voices.at(i);
+			pv->ctlr.reset();
+		}
+	}
 
 	if (m_dco1.envtime0 != *m_dco1.envtime) {
 		m_dco1.envtime0  = *m_dco1.envtime;
@@ -2429,17 +3259,21 @@ void synthv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 
 	dco1_wave1.reset_test(
 		synthv1_wave::Shape(*m_dco1.shape1),
-		*m_dco1.width1, *m_dco1.bandl1 > 0.0f);
+		*m_dco1.width1, *m_dco1.bandl1 > 0.0f,
+		*m_dco1.polyblep > 0.0f);
 	dco1_wave2.reset_test(
 		synthv1_wave::Shape(*m_dco1.shape2),
-		*m_dco1.width2, *m_dco1.bandl2 > 0.0f);
+		*m_dco1.width2, *m_dco1.bandl2 > 0.0f,
+		*m_dco1.polyblep > 0.0f);
 
 	dco2_wave1.reset_test(
 		synthv1_wave::Shape(*m_dco2.shape1),
-		*m_dco2.width1, *m_dco2.bandl1 > 0.0f);
+		*m_dco2.width1, *m_dco2.bandl1 > 0.0f,
+		*m_dco2.polyblep > 0.0f);
 	dco2_wave2.reset_test(
 		synthv1_wave::Shape(*m_dco2.shape2),
-		*m_dco2.width2, *m_dco2.bandl2 > 0.0f);
+		*m_dco2.width2, *m_dco2.bandl2 > 0.0f,
+		*m_dco2.polyblep > 0.0f);
 
 	if (lfo1_enabled) {
 		lfo1_wave.reset_test(
@@ -2450,268 +3284,224 @@ void synthv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 			synthv1_wave::Shape(*m_lfo2.shape), *m_lfo2.width);
 	}
 
-	// per voice
-
-	synthv1_voice *pv = m_play_list.next();
+	// envelope parameters, read-only while rendering voices
 
-	while (pv) {
+	m_dca1.env.update();
+	m_dcf1.env.update();
+	m_lfo1.env.update();
 
-		synthv1_voice *pv_next = pv->next();
+	m_dca2.env.update();
+	m_dcf2.env.update();
+	m_lfo2.env.update();
 
-		// output buffers
+	// per voice
 
-		for (k = 0; k < m_nchannels; ++k) {
-			v_outs[k] = outs[k];
-			v_sfxs[k] = m_sfxs[k];
+	if (m_idle) {
+		// nothing to render...
+	}
+	else
+	if (m_pool) {
+		// parallel, in fixed voice slices...
+		m_nslist = m_voices.count();
+		m_nslice = nframes;
+		m_pool->process(&m_slice_job, MAX_SLICES);
+		// mix-down slices, in fixed order...
+		const uint32_t nslices
+			= (m_nslist < MAX_SLICES ? m_nslist : MAX_SLICES);
+		for (uint32_t i = 0; i < nslices; ++i) {
+			float **s_outs = &m_souts[i * m_nchannels];
+			float **s_sfxs = &m_ssfxs[i * m_nchannels];
+			for (k = 0; k < m_nchannels; ++k) {
+				float *out = outs[k];
+				float *sfx = m_sfxs[k];
+				const float *s_out = s_outs[k];
+				const float *s_sfx = s_sfxs[k];
+				for (uint32_t n = 0; n < nframes; ++n) {
+					*out++ += *s_out++;
+					*sfx++ += *s_sfx++;
+				}
+			}
+		}
+		// free ended voices, in play order...
+		uint32_t nfree = 0;
+		for (uint32_t i = 0; i < m_nslist; ++i) {
+			if (m_sfree[i])
+				free_voice(m_voices.at(i - nfree++));
+		}
+	} else {
+		// serial, straight into output buffers...
+		uint16_t i = 0;
+		while (i < m_voices.count()) {
+			synthv1_voice *pv = m_voices.at(i);
+			if (process_voice(pv, outs, m_sfxs, nframes))
+				free_voice(pv); // next one shifts in here.
+			else
+				++i;
 		}
+	}
 
-		uint32_t nblock = nframes;
+	// effects and output mix-down
+	if (fx_pipe)
+		process_fx_pipe(outs, nframes);
+	else
+	if (!m_idle)
+		process_fx_dispatch(outs, m_sfxs, nframes);
 
-		while (nblock > 0) {
+	// post-processing
+	m_dca1.volume.tick(nframes);
+	m_out1.width.tick(nframes);
+	m_out1.panning.tick(nframes);
+	m_out1.volume.tick(nframes);
 
-			uint32_t ngen = nblock;
+	m_wid1.process(nframes);
+	m_pan1.process(nframes);
+	m_vol1.process(nframes);
 
-			// process envelope stages
+	m_dca2.volume.tick(nframes);
+	m_out2.width.tick(nframes);
+	m_out2.panning.tick(nframes);
+	m_out2.volume.tick(nframes);
 
-			if (pv->dca1_env.running && pv->dca1_env.frames < ngen)
-				ngen = pv->dca1_env.frames;
-			if (pv->dca2_env.running && pv->dca2_env.frames < ngen)
-				ngen = pv->dca2_env.frames;
-			if (pv->dcf1_env.running && pv->dcf1_env.frames < ngen)
-				ngen = pv->dcf1_env.frames;
-			if (pv->dcf2_env.running && pv->dcf2_env.frames < ngen)
-				ngen = pv->dcf2_env.frames;
-			if (pv->lfo1_env.running && pv->lfo1_env.frames < ngen)
-				ngen = pv->lfo1_env.frames;
-			if (pv->lfo2_env.running && pv->lfo2_env.frames < ngen)
-				ngen = pv->lfo2_env.frames;
+	m_wid2.process(nframes);
+	m_pan2.process(nframes);
+	m_vol2.process(nframes);
 
-			for (uint32_t j = 0; j < ngen; ++j) {
+	m_controls.process(nframes);
+}
 
-				// velocities
 
-				const float vel1
-					= (pv->vel1 + (1.0f - pv->vel1) * pv->dca1_pre.value(j));
-				const float vel2
-					= (pv->vel2 + (1.0f - pv->vel2) * pv->dca2_pre.value(j));
+// force inline all of the callees (kernel clones)
 
-				// generators
+#if defined(__GNUC__)
+#define SYNTHV1_FLATTEN __attribute__((flatten))
+#else
+#define SYNTHV1_FLATTEN
+#endif
 
-				const float lfo1_env
-					= (lfo1_enabled ? pv->lfo1_env.tick() : 0.0f);
-				const float lfo2_env
-					= (lfo1_enabled ? pv->lfo2_env.tick() : 0.0f);
 
-				const float lfo1
-					= (lfo1_enabled ? pv->lfo1_sample * lfo1_env : 0.0f);
-				const float lfo2
-					= (lfo2_enabled ? pv->lfo2_sample * lfo2_env : 0.0f);
+// effects dormant (or off)
 
-				const float dco11 = pv->dco1_sample1 * pv->dco1_bal.value(j, 0);
-				const float dco12 = pv->dco1_sample2 * pv->dco1_bal.value(j, 1);
-				const float dco21 = pv->dco2_sample1 * pv->dco2_bal.value(j, 0);
-				const float dco22 = pv->dco2_sample2 * pv->dco2_bal.value(j, 1);
+bool synthv1_impl::fx_dormant (void)
+{
+	// (as effects skip processing below this wet level)
+	const float wet_min = 1E-9f;
 
-				const float dco1_fmod
-					= (m_ctl1.pitchbend + modwheel1 * lfo1);
-				const float dco2_fmod
-					= (m_ctl2.pitchbend + modwheel2 * lfo2);
+	if (m_nchannels > 1) {
+		if (*m_cho.wet >= wet_min && !m_chorus.isDormant())
+			return false;
+		if (*m_rev.wet >= wet_min && !m_reverb.isDormant())
+			return false;
+	}
 
-				pv->dco1_sample1 = pv->dco11.sample(pv->dco1_freq1
-					* dco1_fmod + pv->dco1_glide1.tick());
-				pv->dco1_sample2 = pv->dco12.sample(pv->dco1_freq2
-					* dco1_fmod + pv->dco1_glide2.tick());
+	for (uint16_t k = 0; k < m_nchannels; ++k) {
+		if (*m_fla.wet >= wet_min && !m_flanger[k].isDormant())
+			return false;
+		if (*m_pha.wet >= wet_min && !m_phaser[k].isDormant())
+			return false;
+		if (*m_del.wet >= wet_min && !m_delay[k].isDormant())
+			return false;
+	}
 
-				pv->dco2_sample1 = pv->dco21.sample(pv->dco2_freq1
-					* dco2_fmod + pv->dco2_glide1.tick());
-				pv->dco2_sample2 = pv->dco22.sample(pv->dco2_freq2
-					* dco2_fmod	+ pv->dco2_glide2.tick());
+	return true;
+}
 
-				if (lfo1_enabled) {
-					pv->lfo1_sample = pv->lfo1.sample(lfo1_freq
-						* (1.0f + SWEEP_SCALE * *m_lfo1.sweep * lfo1_env));
-				}
-				if (lfo2_enabled) {
-					pv->lfo2_sample = pv->lfo2.sample(lfo2_freq
-						* (1.0f + SWEEP_SCALE * *m_lfo2.sweep * lfo2_env));
-				}
 
-				// ring modulators
-
-				const float ringmod1 = synthv1_sigmoid_1(
-					*m_dco1.ringmod * (1.0f + *m_lfo1.ringmod * lfo1));
-				const float ringmod2 = synthv1_sigmoid_1(
-					*m_dco2.ringmod * (1.0f + *m_lfo2.ringmod * lfo2));
-
-				float mod11 = dco11 * (1.0f - ringmod1) + dco11 * dco12 * ringmod1;
-				float mod12 = dco12 * (1.0f - ringmod1) + dco12 * dco11 * ringmod1;
-				float mod21 = dco21 * (1.0f - ringmod2) + dco21 * dco22 * ringmod2;
-				float mod22 = dco22 * (1.0f - ringmod2) + dco22 * dco21 * ringmod2;
-
-				// filters
-
-				if (dcf1_enabled) {
-					const float env1 = 0.5f
-						* (1.0f + *m_dcf1.envelope * pv->dcf1_env.tick());
-					const float cutoff1 = synthv1_sigmoid_1(*m_dcf1.cutoff
-						* env1 * (1.0f + *m_lfo1.cutoff * lfo1));
-					const float reso1 = synthv1_sigmoid_1(*m_dcf1.reso
-						* env1 * (1.0f + *m_lfo1.reso * lfo1));
-					switch (int(*m_dcf1.slope)) {
-					case 3: // Formant
-						mod11 = pv->dcf17.output(mod11, cutoff1, reso1);
-						mod12 = pv->dcf18.output(mod12, cutoff1, reso1);
-						break;
-					case 2: // Biquad
-						mod11 = pv->dcf15.output(mod11, cutoff1, reso1);
-						mod12 = pv->dcf16.output(mod12, cutoff1, reso1);
-						break;
-					case 1: // 24db/octave
-						mod11 = pv->dcf13.output(mod11, cutoff1, reso1);
-						mod12 = pv->dcf14.output(mod12, cutoff1, reso1);
-						break;
-					case 0: // 12db/octave
-					default:
-						mod11 = pv->dcf11.output(mod11, cutoff1, reso1);
-						mod12 = pv->dcf12.output(mod12, cutoff1, reso1);
-						break;
-					}
-				}
+// effects and output mix-down (per CPU level)
 
-				if (dcf2_enabled) {
-					const float env2 = 0.5f
-						* (1.0f + *m_dcf2.envelope * pv->dcf2_env.tick());
-					const float cutoff2 = synthv1_sigmoid_1(*m_dcf2.cutoff
-						* env2 * (1.0f + *m_lfo2.cutoff * lfo2));
-					const float reso2 = synthv1_sigmoid_1(*m_dcf2.reso
-						* env2 * (1.0f + *m_lfo2.reso * lfo2));
-					switch (int(*m_dcf2.slope)) {
-					case 3: // Formant
-						mod21 = pv->dcf27.output(mod21, cutoff2, reso2);
-						mod22 = pv->dcf28.output(mod22, cutoff2, reso2);
-						break;
-					case 2: // Biquad
-						mod21 = pv->dcf25.output(mod21, cutoff2, reso2);
-						mod22 = pv->dcf26.output(mod22, cutoff2, reso2);
-						break;
-					case 1: // 24db/octave
-						mod21 = pv->dcf23.output(mod21, cutoff2, reso2);
-						mod22 = pv->dcf24.output(mod22, cutoff2, reso2);
-						break;
-					case 0: // 12db/octave
-					default:
-						mod21 = pv->dcf21.output(mod21, cutoff2, reso2);
-						mod22 = pv->dcf22.output(mod22, cutoff2, reso2);
-						break;
-					}
-				}
+void synthv1_impl::process_fx_dispatch (
+	float **outs, float **sfxs, uint32_t nframes )
+{
+	switch (m_cpu_level) {
+#ifdef SYNTHV1_CPU_DISPATCH
+	case synthv1::CpuAVX512:
+		process_fx_avx512(outs, sfxs, nframes);
+		break;
+	case synthv1::CpuAVX2:
+		process_fx_avx2(outs, sfxs, nframes);
+		break;
+#endif
+	default:
+		process_fx(outs, sfxs, nframes);
+		break;
+	}
+}
 
-				// volumes
-
-				const float wid1 = m_wid1.value(j);
-				const float mid1 = 0.5f * (mod11 + mod12);
-				const float sid1 = 0.5f * (mod11 - mod12);
-				const float vol1 = vel1 * m_vol1.value(j)
-					* pv->dca1_env.tick()
-					* pv->out1_vol.value(j);
-
-				const float wid2 = m_wid2.value(j);
-				const float mid2 = 0.5f * (mod21 + mod22);
-				const float sid2 = 0.5f * (mod21 - mod22);
-				const float vol2 = vel2 * m_vol2.value(j)
-					* pv->dca2_env.tick()
-					* pv->out2_vol.value(j);
-
-				// outputs
-
-				const float out11 = vol1 * (mid1 + sid1 * wid1)
-					* pv->out1_pan.value(j, 0)
-					* m_pan1.value(j, 0);
-				const float out12 = vol1 * (mid1 - sid1 * wid1)
-					* pv->out1_pan.value(j, 1)
-					* m_pan1.value(j, 1);
-				const float out21 = vol2 * (mid2 + sid2 * wid2)
-					* pv->out2_pan.value(j, 0)
-					* m_pan2.value(j, 0);
-				const float out22 = vol2 * (mid2 - sid2 * wid2)
-					* pv->out2_pan.value(j, 1)
-					* m_pan2.value(j, 1);
-
-				for (k = 0; k < m_nchannels; ++k) {
-					const float dry1 = (k & 1 ? out12 : out11);
-					const float dry2 = (k & 1 ? out22 : out21);
-					const float wet1 = fxsend1 * dry1;
-					const float wet2 = fxsend2 * dry2;
-					const float dry = dry1 + dry2;
-					const float wet = wet1 + wet2;
-					*v_outs[k]++ += dry - wet;
-					*v_sfxs[k]++ += wet;
-				}
 
-				if (j == 0) {
-					pv->dco1_balance = lfo1 * *m_lfo1.balance;
-					pv->dco2_balance = lfo2 * *m_lfo2.balance;
-					pv->out1_panning = lfo1 * *m_lfo1.panning;
-					pv->out2_panning = lfo2 * *m_lfo2.panning;
-					pv->out1_volume  = lfo1 * *m_lfo1.volume + 1.0f;
-					pv->out2_volume  = lfo2 * *m_lfo2.volume + 1.0f;
-				}
-			}
-
-			nblock -= ngen;
-
-			// voice ramps countdown
+// effects and output mix-down, pipelined: the current block goes
+// into one period buffer, while the output comes from the other one,
+// the previous period, its effects processed on the helper thread.
 
-			pv->dco1_bal.process(ngen);
-			pv->dco2_bal.process(ngen);
+void synthv1_impl::process_fx_pipe ( float **outs, uint32_t nframes )
+{
+	uint32_t offset = 0;
+
+	while (offset < nframes) {
+		uint32_t nfill = m_fx_period - m_fx_fill;
+		if (nfill > nframes - offset)
+			nfill = nframes - offset;
+		// previous period must be done by now...
+		if (m_fx_busy) {
+			m_fx_pool->wait();
+			m_fx_busy = false;
+		}
+		float **cur_outs = m_fx_outs[m_fx_cur];
+		float **cur_sfxs = m_fx_sfxs[m_fx_cur];
+		float **pre_outs = m_fx_outs[1 - m_fx_cur];
+		for (uint16_t k = 0; k < m_nchannels; ++k) {
+			float *out = outs[k] + offset;
+			float *p = cur_outs[k] + m_fx_fill;
+			float *q = pre_outs[k] + m_fx_fill;
+			::memcpy(cur_sfxs[k] + m_fx_fill,
+				m_sfxs[k] + offset, nfill * sizeof(float));
+			for (uint32_t n = 0; n < nfill; ++n) {
+				const float x = out[n];
+				out[n] = q[n];
+				p[n] = x;
+			}
+		}
+		m_fx_fill += nfill;
+		offset += nfill;
+		// period complete? swap and start its effects...
+		if (m_fx_fill >= m_fx_period) {
+			if (m_idle && m_fx_settle < 2)
+				++m_fx_settle;
+			m_fx_fill = 0;
+			m_fx_cur = 1 - m_fx_cur;
+			m_fx_pool->start(&m_fx_job, 1);
+			m_fx_busy = true;
+		}
+	}
+}
 
-			pv->dca1_pre.process(ngen);
-			pv->dca2_pre.process(ngen);
 
-			pv->out1_pan.process(ngen);
-			pv->out2_pan.process(ngen);
+// effects and output mix-down, previous period (helper thread)
 
-			pv->out1_vol.process(ngen);
-			pv->out2_vol.process(ngen);
+void synthv1_impl::process_fx_job (void)
+{
+	const uint16_t j = 1 - m_fx_cur;
 
-			// envelope countdowns
+	process_fx_dispatch(m_fx_outs[j], m_fx_sfxs[j], m_fx_period);
 
-			if (pv->dca1_env.running && pv->dca1_env.frames == 0)
-				m_dca1.env.next(&pv->dca1_env);
-			if (pv->dca2_env.running && pv->dca2_env.frames == 0)
-				m_dca2.env.next(&pv->dca2_env);
+	m_fx_dormant = fx_dormant();
+}
 
-			if (pv->dca1_env.stage == synthv1_env::End &&
-				pv->dca2_env.stage == synthv1_env::End) {
-				if (pv->note1 < 0 && pv->note2 < 0)
-					free_voice(pv);
-				nblock = 0;
-			} else {
-				if (pv->dcf1_env.running && pv->dcf1_env.frames == 0)
-					m_dcf1.env.next(&pv->dcf1_env);
-				if (pv->dcf2_env.running && pv->dcf2_env.frames == 0)
-					m_dcf2.env.next(&pv->dcf2_env);
-				if (pv->lfo1_env.running && pv->lfo1_env.frames == 0)
-					m_lfo1.env.next(&pv->lfo1_env);
-				if (pv->lfo2_env.running && pv->lfo2_env.frames == 0)
-					m_lfo2.env.next(&pv->lfo2_env);
-			}
-		}
 
-		// next playing voice
+// effects and output mix-down
 
-		pv = pv_next;
-	}
+void synthv1_impl::process_fx (
+	float **outs, float **sfxs, uint32_t nframes )
+{
+	uint16_t k;
 
 	// chorus
 	if (m_nchannels > 1) {
-		m_chorus.process(m_sfxs[0], m_sfxs[1], nframes, *m_cho.wet,
+		m_chorus.process(sfxs[0], sfxs[1], nframes, *m_cho.wet,
 			*m_cho.delay, *m_cho.feedb, *m_cho.rate, *m_cho.mod);
 	}
 
 	// effects
 	for (k = 0; k < m_nchannels; ++k) {
-		float *in = m_sfxs[k];
+		float *in = sfxs[k];
 		// flanger
 		m_flanger[k].process(in, nframes, *m_fla.wet,
 			*m_fla.delay, *m_fla.feedb, *m_fla.daft * float(k));
@@ -2725,17 +3515,21 @@ void synthv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 
 	// reverb
 	if (m_nchannels > 1) {
-		m_reverb.process(m_sfxs[0], m_sfxs[1], nframes, *m_rev.wet,
+		m_reverb.process(sfxs[0], sfxs[1], nframes, *m_rev.wet,
 			*m_rev.feedb, *m_rev.room, *m_rev.damp, *m_rev.width);
 	}
 
+	// compressor (all channels at once)
+	if (int(*m_dyn.compress) > 0) {
+		const uint16_t nchannels = synthv1_fx_comp::MAX_CHANNELS;
+		for (k = 0; k < m_nchannels; k += nchannels)
+			m_comp[k / nchannels].process(sfxs + k, m_nchannels - k, nframes);
+	}
+
 	// output mix-down
 	for (k = 0; k < m_nchannels; ++k) {
 		uint32_t n;
-		float *sfx = m_sfxs[k];
-		// compressor
-		if (int(*m_dyn.compress) > 0)
-			m_comp[k].process(sfx, nframes);
+		float *sfx = sfxs[k];
 		// limiter
 		if (int(*m_dyn.limiter) > 0) {
 			float *p = sfx;
@@ -2748,27 +3542,630 @@ void synthv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 		for (n = 0; n < nframes; ++n)
 			*out++ += *sfx++;
 	}
+}
 
-	// post-processing
-	m_dca1.volume.tick(nframes);
-	m_out1.width.tick(nframes);
-	m_out1.panning.tick(nframes);
-	m_out1.volume.tick(nframes);
 
-	m_wid1.process(nframes);
-	m_pan1.process(nframes);
-	m_vol1.process(nframes);
+#ifdef SYNTHV1_CPU_DISPATCH
 
-	m_dca2.volume.tick(nframes);
-	m_out2.width.tick(nframes);
-	m_out2.panning.tick(nframes);
-	m_out2.volume.tick(nframes);
+// effects and output mix-down, wider instruction set clones.
 
-	m_wid2.process(nframes);
-	m_pan2.process(nframes);
-	m_vol2.process(nframes);
+SYNTHV1_TARGET_AVX2 SYNTHV1_FLATTEN
+void synthv1_impl::process_fx_avx2 (
+	float **outs, float **sfxs, uint32_t nframes )
+{
+	process_fx(outs, sfxs, nframes);
+}
 
-	m_controls.process(nframes);
+SYNTHV1_TARGET_AVX512 SYNTHV1_FLATTEN
+void synthv1_impl::process_fx_avx512 (
+	float **outs, float **sfxs, uint32_t nframes )
+{
+	process_fx(outs, sfxs, nframes);
+}
+
+#endif	// SYNTHV1_CPU_DISPATCH
+
+
+// voice render kernels dispatch (once per block)
+
+const uint32_t DCF_KINDS = 5; // disabled, 12db/oct, 24db/oct, biquad, formant
+const int DCF_FORMANT = 4;
+const uint32_t INTERP_KINDS = 3; // linear, cubic, draft
+
+template <int LEVEL, uint32_t I>
+constexpr synthv1_impl::RenderVoice synthv1_impl::render_voice_entry (void)
+{
+	constexpr int INTERP = int(I / (DCF_KINDS * DCF_KINDS << 2));
+	constexpr int DCF1 = int((I / (DCF_KINDS << 2)) % DCF_KINDS);
+	constexpr int DCF2 = int((I >> 2) % DCF_KINDS);
+	constexpr bool LFO1 = ((I & 2) != 0);
+	constexpr bool LFO2 = ((I & 1) != 0);
+
+#ifdef SYNTHV1_CPU_DISPATCH
+	// (quad lanes are 128 bit wide: AVX-512 gets the AVX2 ones)
+	if constexpr (LEVEL >= synthv1::CpuAVX2)
+		return &synthv1_impl::render_voice_avx2<INTERP, DCF1, DCF2, LFO1, LFO2>;
+#endif
+
+	return &synthv1_impl::render_voice<INTERP, DCF1, DCF2, LFO1, LFO2>;
+}
+
+
+template <int LEVEL, uint32_t... I>
+const synthv1_impl::RenderVoice *synthv1_impl::render_voice_table (
+	std::integer_sequence<uint32_t, I...> )
+{
+	static const RenderVoice s_table[] = {
+		render_voice_entry<LEVEL, I>()...
+	};
+
+	return s_table;
+}
+
+
+static inline uint32_t synthv1_dcf_kind ( const synthv1_snap& snap )
+{
+	if (!snap.dcf_enabled)
+		return 0;
+
+	const int slope = snap.dcf_slope;
+	return 1 + (slope > 0 && slope < 4 ? slope : 0);
+}
+
+
+synthv1_impl::RenderVoice synthv1_impl::render_voice_func (void) const
+{
+	typedef std::make_integer_sequence<uint32_t,
+		INTERP_KINDS * DCF_KINDS * DCF_KINDS * 4> Seq;
+
+	static const RenderVoice *s_table = render_voice_table<synthv1::CpuGeneric>(Seq());
+#ifdef SYNTHV1_CPU_DISPATCH
+	static const RenderVoice *s_table_avx2 = render_voice_table<synthv1::CpuAVX2>(Seq());
+#endif
+
+	const uint32_t i
+		= ((uint32_t(m_interp) * DCF_KINDS + synthv1_dcf_kind(m_snap1))
+			* DCF_KINDS + synthv1_dcf_kind(m_snap2)) << 2
+		| (m_snap1.lfo_enabled ? 2 : 0)
+		| (m_snap2.lfo_enabled ? 1 : 0);
+
+#ifdef SYNTHV1_CPU_DISPATCH
+	if (m_cpu_level >= synthv1::CpuAVX2)
+		return s_table_avx2[i];
+#endif
+
+	return s_table[i];
+}
+
+
+// control-rate modulators, next control point (per voice)
+
+void synthv1_impl::control_voice (
+	synthv1_voice *pv, uint32_t nctl, uint32_t nframe )
+{
+	const synthv1_snap& snap1 = m_snap1;
+	const synthv1_snap& snap2 = m_snap2;
+
+	// keep LFO phase increments below one whole cycle...
+	const float lfo_freq_max = 0.5f * m_srate;
+
+	float lfo1 = 0.0f;
+	float lfo2 = 0.0f;
+
+	if (snap1.lfo_enabled) {
+		const float lfo1_env = pv->lfo1_env.value;
+		lfo1 = pv->lfo1_sample * lfo1_env;
+		float lfo1_freq = float(nctl) * snap1.lfo_freq
+			* (1.0f + SWEEP_SCALE * snap1.lfo_sweep.value(nframe) * lfo1_env);
+		if (lfo1_freq > lfo_freq_max)
+			lfo1_freq = lfo_freq_max;
+		pv->lfo1_sample = pv->lfo1.sample(lfo1_freq);
+	}
+
+	if (snap2.lfo_enabled) {
+		const float lfo2_env = pv->lfo2_env.value;
+		lfo2 = pv->lfo2_sample * lfo2_env;
+		float lfo2_freq = float(nctl) * snap2.lfo_freq
+			* (1.0f + SWEEP_SCALE * snap2.lfo_sweep.value(nframe) * lfo2_env);
+		if (lfo2_freq > lfo_freq_max)
+			lfo2_freq = lfo_freq_max;
+		pv->lfo2_sample = pv->lfo2.sample(lfo2_freq);
+	}
+
+	float target[synthv1_ctlr::NUM_VALUES];
+
+	target[synthv1_ctlr::Lfo1] = lfo1;
+	target[synthv1_ctlr::Lfo2] = lfo2;
+
+	target[synthv1_ctlr::RingMod1] = synthv1_sigmoid_1(snap1.dco_ringmod
+		* (1.0f + snap1.lfo_ringmod.value(nframe) * lfo1));
+	target[synthv1_ctlr::RingMod2] = synthv1_sigmoid_1(snap2.dco_ringmod
+		* (1.0f + snap2.lfo_ringmod.value(nframe) * lfo2));
+
+	const float env1 = 0.5f
+		* (1.0f + snap1.dcf_envelope.value(nframe) * pv->dcf1_env.value);
+	target[synthv1_ctlr::Cutoff1] = synthv1_sigmoid_1(
+		snap1.dcf_cutoff.value(nframe)
+		* env1 * (1.0f + snap1.lfo_cutoff.value(nframe) * lfo1));
+	target[synthv1_ctlr::Reso1] = synthv1_sigmoid_1(
+		snap1.dcf_reso.value(nframe)
+		* env1 * (1.0f + snap1.lfo_reso.value(nframe) * lfo1));
+
+	const float env2 = 0.5f
+		* (1.0f + snap2.dcf_envelope.value(nframe) * pv->dcf2_env.value);
+	target[synthv1_ctlr::Cutoff2] = synthv1_sigmoid_1(
+		snap2.dcf_cutoff.value(nframe)
+		* env2 * (1.0f + snap2.lfo_cutoff.value(nframe) * lfo2));
+	target[synthv1_ctlr::Reso2] = synthv1_sigmoid_1(
+		snap2.dcf_reso.value(nframe)
+		* env2 * (1.0f + snap2.lfo_reso.value(nframe) * lfo2));
+
+	pv->ctlr.reset(target, nctl);
+}
+
+
+// voice filter stage, over the quad lanes in mask (DCF kind > 0).
+
+template <int DCF>
+static inline synthv1_quad synthv1_dcf_output ( synthv1_voice *pv,
+	const synthv1_quad& in, const synthv1_quad& cutoff, const synthv1_quad& reso,
+	uint16_t mask )
+{
+	switch (DCF - 1) {
+	case 3: { // Formant
+		synthv1_quad out = in;
+		if (mask & 0x03) {
+			out[0] = pv->dcf17.output(in[0], cutoff[0], reso[0]);
+			out[1] = pv->dcf18.output(in[1], cutoff[1], reso[1]);
+		}
+		if (mask & 0x0c) {
+			out[2] = pv->dcf27.output(in[2], cutoff[2], reso[2]);
+			out[3] = pv->dcf28.output(in[3], cutoff[3], reso[3]);
+		}
+		return out;
+	}
+	case 2: // Biquad
+		return pv->dcfq3.output(in, cutoff, reso, mask);
+	case 1: // 24db/octave
+		return pv->dcfq2.output(in, cutoff, reso);
+	case 0: // 12db/octave
+	default:
+		return pv->dcfq1.output(in, cutoff, reso);
+	}
+}
+
+
+// oscillator wave table interpolation, over the quad lanes, from
+// raw frames as fetched per table (starting at offset k in each).
+
+template <int INTERP>
+static constexpr uint32_t synthv1_dco_frames (void)
+{
+	return (INTERP == synthv1::InterpCubic ? 4
+		: INTERP == synthv1::InterpDraft ? 1 : 2);
+}
+
+template <int INTERP>
+static inline synthv1_quad synthv1_dco_interp ( const synthv1_quad& alpha,
+	const float *x11, const float *x12, const float *x21, const float *x22,
+	uint32_t k )
+{
+	const synthv1_quad x0
+		= synthv1_quad_set(x11[k], x12[k], x21[k], x22[k]);
+
+	if (INTERP == synthv1::InterpDraft)
+		return x0;
+
+	const synthv1_quad x1
+		= synthv1_quad_set(x11[k + 1], x12[k + 1], x21[k + 1], x22[k + 1]);
+
+	if (INTERP != synthv1::InterpCubic)
+		return x0 + alpha * (x1 - x0);
+
+	// 4-point cubic Hermite, in between x1 and x2.
+	const synthv1_quad x2
+		= synthv1_quad_set(x11[k + 2], x12[k + 2], x21[k + 2], x22[k + 2]);
+	const synthv1_quad x3
+		= synthv1_quad_set(x11[k + 3], x12[k + 3], x21[k + 3], x22[k + 3]);
+
+	const synthv1_quad c1 = (x2 - x0) * 0.5f;
+	const synthv1_quad b1 = (x1 - x2);
+	const synthv1_quad b2 = (c1 + b1);
+	const synthv1_quad c3 = (x3 - x1) * 0.5f + b2 + b1;
+	const synthv1_quad c2 = (c3 + b2);
+
+	return (((c3 * alpha) - c2) * alpha + c1) * alpha + x1;
+}
+
+
+// voice render kernel (per envelope stage run); all the per sample
+// helpers are forced inline, as there are quite a few instances.
+//
+// the four oscillators and filters run side by side, as quad lanes
+// (dco11, dco12, dco21, dco22), one SIMD register wide; these may run
+// oversampled (2x or 4x), decimated back to one frame before the mix.
+
+template <int INTERP, int DCF1, int DCF2, bool LFO1, bool LFO2>
+SYNTHV1_FLATTEN
+void synthv1_impl::render_voice (
+	synthv1_voice *pv, float **v_outs, float **v_sfxs,
+	uint32_t nframe, uint32_t ngen )
+{
+	const synthv1_snap& snap1 = m_snap1;
+	const synthv1_snap& snap2 = m_snap2;
+
+	const bool lfo1_enabled = LFO1;
+	const bool lfo2_enabled = LFO2;
+
+	const uint32_t nctl = m_nctl;
+
+	const uint32_t nover = m_nover;
+	const float over_inv = 1.0f / float(nover);
+
+	synthv1_ctlr& ctlr = pv->ctlr;
+
+	synthv1_quad dco_sample = synthv1_quad_set(
+		pv->dco1_sample1, pv->dco1_sample2,
+		pv->dco2_sample1, pv->dco2_sample2);
+
+	const synthv1_quad dco_ftab = synthv1_quad_set(
+		pv->dco11.ftab(), pv->dco12.ftab(),
+		pv->dco21.ftab(), pv->dco22.ftab());
+
+	uint16_t k;
+
+	for (uint32_t j = 0; j < ngen; ++j) {
+
+		// (block frame offset, smoothed parameters)
+		const uint32_t jframe = nframe + j;
+
+		// velocities
+
+		const float vel1
+			= (pv->vel1 + (1.0f - pv->vel1) * pv->dca1_pre.value(j));
+		const float vel2
+			= (pv->vel2 + (1.0f - pv->vel2) * pv->dca2_pre.value(j));
+
+		// generators
+
+		const float lfo1_env
+			= (lfo1_enabled ? pv->lfo1_env.tick() : 0.0f);
+		const float lfo2_env
+			= (lfo2_enabled ? pv->lfo2_env.tick() : 0.0f);
+
+		// control-rate modulators, interpolated...
+		if (nctl > 0) {
+			if (ctlr.frames == 0)
+				control_voice(pv, nctl, nframe + j);
+			ctlr.tick();
+		}
+
+		const float lfo1 = (nctl > 0 ? ctlr.value[synthv1_ctlr::Lfo1]
+			: lfo1_enabled ? pv->lfo1_sample * lfo1_env : 0.0f);
+		const float lfo2 = (nctl > 0 ? ctlr.value[synthv1_ctlr::Lfo2]
+			: lfo2_enabled ? pv->lfo2_sample * lfo2_env : 0.0f);
+
+		const synthv1_quad dco_bal = synthv1_quad_set(
+			pv->dco1_bal.value(j, 0), pv->dco1_bal.value(j, 1),
+			pv->dco2_bal.value(j, 0), pv->dco2_bal.value(j, 1));
+
+		const float dco1_fmod
+			= (m_ctl1.pitchbend + snap1.modwheel * lfo1);
+		const float dco2_fmod
+			= (m_ctl2.pitchbend + snap2.modwheel * lfo2);
+
+		float dco_freq11 = pv->dco1_freq1 * dco1_fmod + pv->dco1_glide1.tick();
+		float dco_freq12 = pv->dco1_freq2 * dco1_fmod + pv->dco1_glide2.tick();
+
+		float dco_freq21 = pv->dco2_freq1 * dco2_fmod + pv->dco2_glide1.tick();
+		float dco_freq22 = pv->dco2_freq2 * dco2_fmod + pv->dco2_glide2.tick();
+
+		// (phase increments, per oversampled frame)
+		if (nover > 1) {
+			dco_freq11 *= over_inv;
+			dco_freq12 *= over_inv;
+			dco_freq21 *= over_inv;
+			dco_freq22 *= over_inv;
+		}
+
+		if (lfo1_enabled && nctl == 0) {
+			pv->lfo1_sample = pv->lfo1.sample(snap1.lfo_freq
+				* (1.0f + SWEEP_SCALE * snap1.lfo_sweep.value(jframe) * lfo1_env));
+		}
+		if (lfo2_enabled && nctl == 0) {
+			pv->lfo2_sample = pv->lfo2.sample(snap2.lfo_freq
+				* (1.0f + SWEEP_SCALE * snap2.lfo_sweep.value(jframe) * lfo2_env));
+		}
+
+		// ring modulators
+
+		const float ringmod1 = (nctl > 0 ? ctlr.value[synthv1_ctlr::RingMod1]
+			: synthv1_sigmoid_1(
+				snap1.dco_ringmod * (1.0f + snap1.lfo_ringmod.value(jframe) * lfo1)));
+		const float ringmod2 = (nctl > 0 ? ctlr.value[synthv1_ctlr::RingMod2]
+			: synthv1_sigmoid_1(
+				snap2.dco_ringmod * (1.0f + snap2.lfo_ringmod.value(jframe) * lfo2)));
+
+		const synthv1_quad ringmod
+			= synthv1_quad_set(ringmod1, ringmod1, ringmod2, ringmod2);
+
+		// filters
+
+		float cutoff1 = 0.0f, reso1 = 0.0f;
+		float cutoff2 = 0.0f, reso2 = 0.0f;
+
+		if (DCF1 > 0) {
+			const float env1 = 0.5f
+				* (1.0f + snap1.dcf_envelope.value(jframe) * pv->dcf1_env.tick());
+			cutoff1 = (nctl > 0 ? ctlr.value[synthv1_ctlr::Cutoff1]
+				: synthv1_sigmoid_1(snap1.dcf_cutoff.value(jframe)
+					* env1 * (1.0f + snap1.lfo_cutoff.value(jframe) * lfo1)));
+			reso1 = (nctl > 0 ? ctlr.value[synthv1_ctlr::Reso1]
+				: synthv1_sigmoid_1(snap1.dcf_reso.value(jframe)
+					* env1 * (1.0f + snap1.lfo_reso.value(jframe) * lfo1)));
+			// (formant ones are set to the oversampled rate instead)
+			if (DCF1 < DCF_FORMANT && nover > 1)
+				cutoff1 *= over_inv;
+		}
+
+		if (DCF2 > 0) {
+			const float env2 = 0.5f
+				* (1.0f + snap2.dcf_envelope.value(jframe) * pv->dcf2_env.tick());
+			cutoff2 = (nctl > 0 ? ctlr.value[synthv1_ctlr::Cutoff2]
+				: synthv1_sigmoid_1(snap2.dcf_cutoff.value(jframe)
+					* env2 * (1.0f + snap2.lfo_cutoff.value(jframe) * lfo2)));
+			reso2 = (nctl > 0 ? ctlr.value[synthv1_ctlr::Reso2]
+				: synthv1_sigmoid_1(snap2.dcf_reso.value(jframe)
+					* env2 * (1.0f + snap2.lfo_reso.value(jframe) * lfo2)));
+			if (DCF2 < DCF_FORMANT && nover > 1)
+				cutoff2 *= over_inv;
+		}
+
+		const synthv1_quad cutoff
+			= synthv1_quad_set(cutoff1, cutoff1, cutoff2, cutoff2);
+		const synthv1_quad reso
+			= synthv1_quad_set(reso1, reso1, reso2, reso2);
+
+		// oscillators, ring modulators and filters, oversampled
+		// (nover frames), decimated back down to one frame...
+
+		synthv1_quad mods[4];
+
+		for (uint32_t n = 0; n < nover; ++n) {
+
+			const synthv1_quad dco = dco_sample * dco_bal;
+
+			constexpr uint32_t NFRAMES = synthv1_dco_frames<INTERP>();
+
+			float x11[NFRAMES << 1], x12[NFRAMES << 1];
+			float x21[NFRAMES << 1], x22[NFRAMES << 1];
+
+			const float alpha11
+				= pv->dco11.sample_frames<NFRAMES>(dco_freq11, x11);
+			const float alpha12
+				= pv->dco12.sample_frames<NFRAMES>(dco_freq12, x12);
+
+			const float alpha21
+				= pv->dco21.sample_frames<NFRAMES>(dco_freq21, x21);
+			const float alpha22
+				= pv->dco22.sample_frames<NFRAMES>(dco_freq22, x22);
+
+			// wavetable interpolation (quad lanes)
+			const synthv1_quad alpha
+				= synthv1_quad_set(alpha11, alpha12, alpha21, alpha22);
+			const synthv1_quad xa = synthv1_dco_interp<INTERP>(
+				alpha, x11, x12, x21, x22, 0);
+			const synthv1_quad xb = synthv1_dco_interp<INTERP>(
+				alpha, x11, x12, x21, x22, NFRAMES);
+			dco_sample = xa + dco_ftab * (xb - xa);
+
+			synthv1_quad mod = dco * (1.0f - ringmod)
+				+ dco * synthv1_quad_swap(dco) * ringmod;
+
+			if (DCF1 > 0 || DCF2 > 0) {
+				if (DCF1 == DCF2) {
+					mod = synthv1_dcf_output<DCF1>(pv, mod, cutoff, reso, 0x0f);
+				} else {
+					// different kinds: lower lanes from one, upper from the other.
+					synthv1_quad mod1 = mod;
+					synthv1_quad mod2 = mod;
+					if (DCF1 > 0)
+						mod1 = synthv1_dcf_output<DCF1>(pv, mod, cutoff, reso, 0x03);
+					if (DCF2 > 0)
+						mod2 = synthv1_dcf_output<DCF2>(pv, mod, cutoff, reso, 0x0c);
+					mod = synthv1_quad_merge(mod1, mod2);
+				}
+			}
+
+			mods[n] = mod;
+		}
+
+		if (nover > 2) {
+			mods[0] = pv->over42.output(mods[0], mods[1]);
+			mods[1] = pv->over42.output(mods[2], mods[3]);
+		}
+		if (nover > 1)
+			mods[0] = pv->over21.output(mods[0], mods[1]);
+
+		const synthv1_quad& mod = mods[0];
+		const float mod11 = mod[0];
+		const float mod12 = mod[1];
+		const float mod21 = mod[2];
+		const float mod22 = mod[3];
+
+		// volumes
+
+		const float wid1 = m_wid1.value(j);
+		const float mid1 = 0.5f * (mod11 + mod12);
+		const float sid1 = 0.5f * (mod11 - mod12);
+		const float vol1 = vel1 * m_vol1.value(j)
+			* pv->dca1_env.tick()
+			* pv->out1_vol.value(j);
+
+		const float wid2 = m_wid2.value(j);
+		const float mid2 = 0.5f * (mod21 + mod22);
+		const float sid2 = 0.5f * (mod21 - mod22);
+		const float vol2 = vel2 * m_vol2.value(j)
+			* pv->dca2_env.tick()
+			* pv->out2_vol.value(j);
+
+		// outputs
+
+		const float out11 = vol1 * (mid1 + sid1 * wid1)
+			* pv->out1_pan.value(j, 0)
+			* m_pan1.value(j, 0);
+		const float out12 = vol1 * (mid1 - sid1 * wid1)
+			* pv->out1_pan.value(j, 1)
+			* m_pan1.value(j, 1);
+		const float out21 = vol2 * (mid2 + sid2 * wid2)
+			* pv->out2_pan.value(j, 0)
+			* m_pan2.value(j, 0);
+		const float out22 = vol2 * (mid2 - sid2 * wid2)
+			* pv->out2_pan.value(j, 1)
+			* m_pan2.value(j, 1);
+
+		for (k = 0; k < m_nchannels; ++k) {
+			const float dry1 = (k & 1 ? out12 : out11);
+			const float dry2 = (k & 1 ? out22 : out21);
+			const float wet1 = snap1.out_fxsend * dry1;
+			const float wet2 = snap2.out_fxsend * dry2;
+			const float dry = dry1 + dry2;
+			const float wet = wet1 + wet2;
+			*v_outs[k]++ += dry - wet;
+			*v_sfxs[k]++ += wet;
+		}
+
+		if (j == 0) {
+			pv->dco1_balance = lfo1 * snap1.lfo_balance;
+			pv->dco2_balance = lfo2 * snap2.lfo_balance;
+			pv->out1_panning = lfo1 * snap1.lfo_panning;
+			pv->out2_panning = lfo2 * snap2.lfo_panning;
+			pv->out1_volume  = lfo1 * snap1.lfo_volume + 1.0f;
+			pv->out2_volume  = lfo2 * snap2.lfo_volume + 1.0f;
+		}
+	}
+
+	pv->dco1_sample1 = dco_sample[0];
+	pv->dco1_sample2 = dco_sample[1];
+	pv->dco2_sample1 = dco_sample[2];
+	pv->dco2_sample2 = dco_sample[3];
+}
+
+
+#ifdef SYNTHV1_CPU_DISPATCH
+
+// voice render kernel, AVX2 clone.
+
+template <int INTERP, int DCF1, int DCF2, bool LFO1, bool LFO2>
+SYNTHV1_TARGET_AVX2 SYNTHV1_FLATTEN
+void synthv1_impl::render_voice_avx2 (
+	synthv1_voice *pv, float **v_outs, float **v_sfxs,
+	uint32_t nframe, uint32_t ngen )
+{
+	render_voice<INTERP, DCF1, DCF2, LFO1, LFO2>(pv, v_outs, v_sfxs, nframe, ngen);
+}
+
+#endif	// SYNTHV1_CPU_DISPATCH
+
+
+// voice processing, returns true if voice is to be freed
+
+bool synthv1_impl::process_voice (
+	synthv1_voice *pv, float **outs, float **sfxs, uint32_t nframes )
+{
+	float *v_outs[m_nchannels];
+	float *v_sfxs[m_nchannels];
+
+	uint16_t k;
+
+	for (k = 0; k < m_nchannels; ++k) {
+		v_outs[k] = outs[k];
+		v_sfxs[k] = sfxs[k];
+	}
+
+	uint32_t nblock = nframes;
+
+	while (nblock > 0) {
+
+		uint32_t ngen = nblock;
+
+		// process envelope stages
+
+		if (pv->dca1_env.running && pv->dca1_env.frames < ngen)
+			ngen = pv->dca1_env.frames;
+		if (pv->dca2_env.running && pv->dca2_env.frames < ngen)
+			ngen = pv->dca2_env.frames;
+		if (pv->dcf1_env.running && pv->dcf1_env.frames < ngen)
+			ngen = pv->dcf1_env.frames;
+		if (pv->dcf2_env.running && pv->dcf2_env.frames < ngen)
+			ngen = pv->dcf2_env.frames;
+		if (pv->lfo1_env.running && pv->lfo1_env.frames < ngen)
+			ngen = pv->lfo1_env.frames;
+		if (pv->lfo2_env.running && pv->lfo2_env.frames < ngen)
+			ngen = pv->lfo2_env.frames;
+
+		// render voice samples
+
+		(this->*m_render_voice)(pv, v_outs, v_sfxs, nframes - nblock, ngen);
+
+		nblock -= ngen;
+
+		// voice ramps countdown
+
+		pv->dco1_bal.process(ngen);
+		pv->dco2_bal.process(ngen);
+
+		pv->dca1_pre.process(ngen);
+		pv->dca2_pre.process(ngen);
+
+		pv->out1_pan.process(ngen);
+		pv->out2_pan.process(ngen);
+
+		pv->out1_vol.process(ngen);
+		pv->out2_vol.process(ngen);
+
+		// envelope countdowns
+
+		if (pv->dca1_env.running && pv->dca1_env.frames == 0)
+			m_dca1.env.next(&pv->dca1_env);
+		if (pv->dca2_env.running && pv->dca2_env.frames == 0)
+			m_dca2.env.next(&pv->dca2_env);
+
+		if (pv->dca1_env.stage == synthv1_env::End &&
+			pv->dca2_env.stage == synthv1_env::End)
+			return (pv->note1 < 0 && pv->note2 < 0);
+
+		if (pv->dcf1_env.running && pv->dcf1_env.frames == 0)
+			m_dcf1.env.next(&pv->dcf1_env);
+		if (pv->dcf2_env.running && pv->dcf2_env.frames == 0)
+			m_dcf2.env.next(&pv->dcf2_env);
+		if (pv->lfo1_env.running && pv->lfo1_env.frames == 0)
+			m_lfo1.env.next(&pv->lfo1_env);
+		if (pv->lfo2_env.running && pv->lfo2_env.frames == 0)
+			m_lfo2.env.next(&pv->lfo2_env);
+	}
+
+	return false;
+}
+
+
+// voice slice processing (parallel)
+
+void synthv1_impl::process_slice ( uint32_t islice )
+{
+	if (islice >= m_nslist)
+		return;
+
+	float **s_outs = &m_souts[islice * m_nchannels];
+	float **s_sfxs = &m_ssfxs[islice * m_nchannels];
+
+	for (uint16_t k = 0; k < m_nchannels; ++k) {
+		::memset(s_outs[k], 0, m_nslice * sizeof(float));
+		::memset(s_sfxs[k], 0, m_nslice * sizeof(float));
+	}
+
+	for (uint32_t i = islice; i < m_nslist; i += MAX_SLICES)
+		m_sfree[i] = process_voice(m_voices.at(i), s_outs, s_sfxs, m_nslice);
 }
 
 
@@ -2781,13 +4178,21 @@ bool synthv1_impl::running ( bool on )
 }
 
 
+// idle state (as of last processed block).
+bool synthv1_impl::isIdle (void) const
+{
+	return m_idle;
+}
+
+
 //-------------------------------------------------------------------------
 // synthv1 - decl.
 //
 
-synthv1::synthv1 ( uint16_t nchannels, float srate, uint32_t nsize )
+synthv1::synthv1 (
+	uint16_t nchannels, float srate, uint32_t nsize, uint16_t nvoices )
 {
-	m_pImpl = new synthv1_impl(this, nchannels, srate, nsize);
+	m_pImpl = new synthv1_impl(this, nchannels, srate, nsize, nvoices);
 }
 
 
@@ -2845,6 +4250,12 @@ float synthv1::tempo (void) const
 }
 
 
+uint16_t synthv1::polyphony (void) const
+{
+	return m_pImpl->polyphony();
+}
+
+
 void synthv1::setParamPort ( ParamIndex index, float *pfParam )
 {
 	m_pImpl->setParamPort(index, pfParam);
@@ -2910,6 +4321,13 @@ bool synthv1::running ( bool on )
 }
 
 
+// idle state: no voices playing, effects tails decayed.
+bool synthv1::isIdle (void) const
+{
+	return m_pImpl->isIdle();
+}
+
+
 // all stabilize
 
 void synthv1::stabilize (void)
@@ -2948,6 +4366,114 @@ void synthv1::directNoteOn ( int note, int vel )
 }
 
 
+// Parallel voice rendering (0 = none, serial).
+// (not real-time safe: processing is held off meanwhile)
+void synthv1::setVoiceThreads ( uint16_t nthreads )
+{
+	const bool running = m_pImpl->running(false);
+	m_pImpl->setVoiceThreads(nthreads);
+	m_pImpl->running(running);
+}
+
+uint16_t synthv1::voiceThreads (void) const
+{
+	return m_pImpl->voiceThreads();
+}
+
+
+// Voice stealing policy (when polyphony is exhausted).
+void synthv1::setVoiceSteal ( VoiceSteal steal )
+{
+	m_pImpl->setVoiceSteal(steal);
+}
+
+synthv1::VoiceSteal synthv1::voiceSteal (void) const
+{
+	return m_pImpl->voiceSteal();
+}
+
+
+// Control-rate modulation period (0 = none, per sample).
+void synthv1::setControlRate ( uint16_t nframes )
+{
+	m_pImpl->setControlRate(nframes);
+}
+
+uint16_t synthv1::controlRate (void) const
+{
+	return m_pImpl->controlRate();
+}
+
+
+// DSP kernels instruction set level (runtime CPU dispatch).
+void synthv1::setCpuLevel ( CpuLevel level )
+{
+	m_pImpl->setCpuLevel(level);
+}
+
+synthv1::CpuLevel synthv1::cpuLevel (void) const
+{
+	return m_pImpl->cpuLevel();
+}
+
+
+// Oscillator wave table interpolation quality.
+void synthv1::setInterpolation ( Interp interp )
+{
+	m_pImpl->setInterpolation(interp);
+}
+
+synthv1::Interp synthv1::interpolation (void) const
+{
+	return m_pImpl->interpolation();
+}
+
+
+// Voice oscillators and filters oversampling.
+void synthv1::setOversampling ( Oversample over )
+{
+	m_pImpl->setOversampling(over);
+}
+
+synthv1::Oversample synthv1::oversampling (void) const
+{
+	return m_pImpl->oversampling();
+}
+
+
+// Oscillator width morphing (precomputed width table banks).
+void synthv1::setWidthMorph ( bool wmorph )
+{
+	m_pImpl->setWidthMorph(wmorph);
+}
+
+bool synthv1::isWidthMorph (void) const
+{
+	return m_pImpl->isWidthMorph();
+}
+
+
+// Effects chain pipelined on a helper thread.
+void synthv1::setFxPipeline ( uint32_t nframes )
+{
+	const bool running = m_pImpl->running(false);
+	m_pImpl->setFxPipeline(nframes);
+	m_pImpl->running(running);
+}
+
+uint32_t synthv1::fxPipeline (void) const
+{
+	return m_pImpl->fxPipeline();
+}
+
+
+// Processing latency (frames).
+uint32_t synthv1::latency (void) const
+{
+	return m_pImpl->latency();
+}
+
+
 // Micro-tuning support
 void synthv1::setTuningEnabled ( bool enabled )
 {
@@ -1,7 +1,7 @@
 // synthv1.h
 //
 /****************************************************************************
-   Copyright (C) 2012-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -42,7 +42,9 @@ class synthv1
 {
 public:
 
-	synthv1(uint16_t nchannels = 2, float srate = 44100.0f, uint32_t nsize = 1024);
+	// nvoices: polyphony, preallocated voices (0 = default, as configured).
+	synthv1(uint16_t nchannels = 2, float srate = 44100.0f,
+		uint32_t nsize = 1024, uint16_t nvoices = 0);
 
 	virtual ~synthv1();
 
@@ -58,6 +60,8 @@ public:
 	void setTempo(float bpm);
 	float tempo() const;
 
+	uint16_t polyphony() const;
+
 	enum ParamIndex	 {
 
 		DCO1_SHAPE1 = 0,
@@ -211,6 +215,9 @@ public:
 		KEY1_LOW,
 		KEY1_HIGH,
 
+		DCO1_POLYBLEP,
+		DCO2_POLYBLEP,
+
 		NUM_PARAMS
 	};
 
@@ -225,6 +232,9 @@ public:
 
 	bool running(bool on);
 
+	// idle (input passthrough only), as of the last processed block.
+	bool isIdle() const;
+
 	void stabilize();
 	void reset();
 
@@ -240,6 +250,71 @@ public:
 
 	void directNoteOn(int note, int vel);
 
+	// parallel voice rendering (0 = none, serial); reallocates the
+	// pool and buffers, so never while process() is in flight (eg.
+	// on instantiation or deactivated, otherwise on the audio thread).
+	void setVoiceThreads(uint16_t nthreads);
+	uint16_t voiceThreads() const;
+
+	// voice stealing policies (when polyphony is exhausted).
+	enum VoiceSteal {
+		StealNone = 0,		// drop new notes (default)
+		StealOldest,		// oldest voice
+		StealQuietest,		// lowest amplitude envelope
+		StealReleased,		// oldest released voice first
+		StealSameNote		// same note key first
+	};
+
+	void setVoiceSteal(VoiceSteal steal);
+	VoiceSteal voiceSteal() const;
+
+	// control-rate modulation period, in frames (0 = none, per sample).
+	void setControlRate(uint16_t nframes);
+	uint16_t controlRate() const;
+
+	// DSP kernels instruction set level (runtime CPU dispatch).
+	enum CpuLevel {
+		CpuAuto = 0,		// best one detected (default)
+		CpuGeneric,			// build target baseline (eg. SSE2 on x86-64)
+		CpuAVX2,			// x86 AVX2
+		CpuAVX512			// x86 AVX-512F
+	};
+
+	void setCpuLevel(CpuLevel level);
+	CpuLevel cpuLevel() const;
+
+	// oscillator wave table interpolation quality.
+	enum Interp {
+		InterpLinear = 0,	// linear (default)
+		InterpCubic,		// cubic Hermite, 4-point
+		InterpDraft			// drop-sample, no interpolation
+	};
+
+	void setInterpolation(Interp interp);
+	Interp interpolation() const;
+
+	// voice oscillators, ring modulators and filters oversampling.
+	enum Oversample {
+		Oversample1x = 0,	// none (default)
+		Oversample2x,		// 2x, half-band decimated
+		Oversample4x		// 4x, two half-band decimators
+	};
+
+	void setOversampling(Oversample over);
+	Oversample oversampling() const;
+
+	// oscillator width morphing (precomputed width table banks).
+	void setWidthMorph(bool wmorph);
+	bool isWidthMorph() const;
+
+	// effects chain pipelined on a helper thread, one period behind
+	// (0 = none, serial; otherwise the period, in frames).
+	void setFxPipeline(uint32_t nframes);
+	uint32_t fxPipeline() const;
+
+	// processing latency, in frames (pipelined effects period).
+	uint32_t latency() const;
+
 	void setTuningEnabled(bool enabled);
 	bool isTuningEnabled() const;
 
@@ -0,0 +1,178 @@
+// synthv1_bank.h
+//
+/****************************************************************************
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __synthv1_bank_h
+#define __synthv1_bank_h
+
+#include <cstdint>
+#include <cstring>
+
+#include <new>
+
+
+//-------------------------------------------------------------------------
+// synthv1_bank - fixed size item bank (voice pool).
+//
+// items are laid out contiguously, in one (aligned) block; the ones in
+// play are kept in a dense index array, in play (allocation) order, while
+// the free ones are recycled in first-in, first-out order.
+
+template<typename T>
+class synthv1_bank
+{
+public:
+
+	synthv1_bank() : m_items(nullptr), m_nitems(0),
+		m_play(nullptr), m_nplay(0),
+		m_free(nullptr), m_ifree(0), m_nfree(0) {}
+
+	~synthv1_bank() { clear(); }
+
+	// (re)allocate and construct all items.
+	template<typename Arg>
+	void alloc(uint16_t nitems, Arg arg)
+	{
+		clear();
+
+		m_items = static_cast<T *> (::operator new [] (
+			nitems * sizeof(T), std::align_val_t(alignof(T))));
+		m_nitems = nitems;
+
+		m_play = new uint16_t [nitems];
+		m_nplay = 0;
+
+		m_free = new uint16_t [nitems];
+		m_ifree = 0;
+		m_nfree = nitems;
+
+		for (uint16_t i = 0; i < nitems; ++i) {
+			::new (&m_items[i]) T(arg);
+			m_free[i] = i;
+		}
+	}
+
+	// destroy and deallocate all items.
+	void clear()
+	{
+		if (m_items == nullptr)
+			return;
+
+		for (uint16_t i = 0; i < m_nitems; ++i)
+			m_items[i].~T();
+
+		::operator delete [] (m_items, std::align_val_t(alignof(T)));
+		m_items = nullptr;
+		m_nitems = 0;
+
+		delete [] m_free;
+		m_free = nullptr;
+		m_ifree = m_nfree = 0;
+
+		delete [] m_play;
+		m_play = nullptr;
+		m_nplay = 0;
+	}
+
+	// items in play (dense, in play order).
+	uint16_t count() const
+		{ return m_nplay; }
+
+	T *at(uint16_t i) const
+		{ return &m_items[m_play[i]]; }
+
+	// item before another in play order, if any.
+	T *prev(T *p) const
+	{
+		const uint16_t i = play_index(p);
+		return (i > 0 && i < m_nplay ? at(i - 1) : nullptr);
+	}
+
+	// items available.
+	uint16_t free_count() const
+		{ return m_nfree; }
+
+	// take the first free item into play, if any.
+	T *acquire()
+	{
+		if (m_nfree < 1)
+			return nullptr;
+
+		const uint16_t index = m_free[m_ifree];
+		if (++m_ifree >= m_nitems)
+			m_ifree = 0;
+		--m_nfree;
+
+		m_play[m_nplay++] = index;
+
+		return &m_items[index];
+	}
+
+	// put an item in play back to the free end.
+	void release(T *p)
+	{
+		const uint16_t i = play_index(p);
+		if (i >= m_nplay)
+			return;
+
+		const uint16_t index = m_play[i];
+
+		--m_nplay;
+		::memmove(&m_play[i], &m_play[i + 1],
+			(m_nplay - i) * sizeof(uint16_t));
+
+		uint32_t j = m_ifree + m_nfree;
+		if (j >= m_nitems)
+			j -= m_nitems;
+		m_free[j] = index;
+		++m_nfree;
+	}
+
+protected:
+
+	// position in play (or count, when not found).
+	uint16_t play_index(T *p) const
+	{
+		const uint16_t index = uint16_t(p - m_items);
+
+		uint16_t i = 0;
+		while (i < m_nplay && m_play[i] != index)
+			++i;
+
+		return i;
+	}
+
+private:
+
+	T        *m_items;
+	uint16_t  m_nitems;
+
+	uint16_t *m_play;
+	uint16_t  m_nplay;
+
+	uint16_t *m_free;
+	uint16_t  m_ifree;
+	uint16_t  m_nfree;
+};
+
+
+#endif	// __synthv1_bank_h
+
+// end of synthv1_bank.h
@@ -0,0 +1,939 @@
+// synthv1_bench.cpp
+//
+/****************************************************************************
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "synthv1.h"
+#include "synthv1_param.h"
+#include "synthv1_wave.h"
+#include "synthv1_fastmath.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include <chrono>
+#include <complex>
+#include <vector>
+
+
+//-------------------------------------------------------------------------
+// synthv1_bench - headless engine instance decl.
+//
+
+// DSP kernels instruction set level (-l option; 0 = auto).
+static synthv1::CpuLevel g_cpu_level = synthv1::CpuAuto;
+
+class synthv1_bench : public synthv1
+{
+public:
+
+	synthv1_bench(uint16_t nvoices, float srate, uint32_t nsize)
+		: synthv1(2, srate, nsize, nvoices)
+	{
+		for (int i = 0; i < synthv1::NUM_PARAMS; ++i) {
+			const synthv1::ParamIndex index = synthv1::ParamIndex(i);
+			m_params[i] = synthv1_param::paramDefaultValue(index);
+			synthv1::setParamPort(index, &m_params[i]);
+		}
+
+		// synth 1 and 2 on separate channels, one voice per note each.
+		m_params[synthv1::DEF1_CHANNEL] = 1.0f;
+		m_params[synthv1::DEF2_CHANNEL] = 2.0f;
+
+		// engine options pinned, never inherited from user
+		// settings (/Engine); each run sets its own from here.
+		synthv1::setVoiceThreads(0);
+		synthv1::setVoiceSteal(synthv1::StealNone);
+		synthv1::setControlRate(0);
+		synthv1::setCpuLevel(g_cpu_level);
+		synthv1::setInterpolation(synthv1::InterpLinear);
+		synthv1::setOversampling(synthv1::Oversample1x);
+		synthv1::setWidthMorph(false);
+		synthv1::setFxPipeline(0);
+
+		synthv1::reset();
+	}
+
+	void setParam(synthv1::ParamIndex index, float fValue)
+		{ m_params[index] = fValue; }
+
+	void updatePreset(bool) {}
+	void updateParam(synthv1::ParamIndex) {}
+	void updateParams() {}
+	void updateTuning() {}
+
+private:
+
+	float m_params[synthv1::NUM_PARAMS];
+};
+
+
+//-------------------------------------------------------------------------
+// synthv1_bench - voice count scaling run.
+//
+
+// trigger as many voices (128 notes per synth channel).
+static void bench_notes_on ( synthv1 *pSynth, uint16_t nvoices )
+{
+	for (uint16_t i = 0; i < nvoices; ++i) {
+		uint8_t data[3];
+		data[0] = 0x90 | (i < 128 ? 0 : 1);
+		data[1] = uint8_t(i & 0x7f);
+		data[2] = 100;
+		pSynth->process_midi(data, 3);
+	}
+}
+
+
+// per-block processing cost (usec), on a ready instance.
+static double bench_process ( synthv1_bench *pSynth,
+	uint16_t nvoices, uint32_t nframes, uint32_t nblocks )
+{
+	float *ins[2], *outs[2];
+	for (uint16_t k = 0; k < 2; ++k) {
+		ins[k]  = new float [nframes];
+		outs[k] = new float [nframes];
+		::memset(ins[k], 0, nframes * sizeof(float));
+	}
+
+	pSynth->stabilize();
+
+	// let the new wave tables in, before the notes start
+	// (table selection is set on note-on).
+	for (uint32_t n = 0; n < 4; ++n)
+		pSynth->process(ins, outs, nframes);
+
+	bench_notes_on(pSynth, nvoices);
+
+	// warm-up (at least 8 blocks, 4096 frames)...
+	for (uint32_t n = 0; n < 8 || n * nframes < 4096; ++n)
+		pSynth->process(ins, outs, nframes);
+
+	const auto t0 = std::chrono::steady_clock::now();
+	for (uint32_t n = 0; n < nblocks; ++n)
+		pSynth->process(ins, outs, nframes);
+	const auto t1 = std::chrono::steady_clock::now();
+
+	for (uint16_t k = 0; k < 2; ++k) {
+		delete [] outs[k];
+		delete [] ins[k];
+	}
+
+	return std::chrono::duration<double, std::micro>(t1 - t0).count()
+		/ double(nblocks);
+}
+
+
+// per-block processing cost (usec), default patch.
+static double bench_run ( uint16_t nvoices,
+	float srate, uint32_t nframes, uint32_t nblocks )
+{
+	synthv1_bench synth(nvoices, srate, nframes);
+
+	return bench_process(&synth, nvoices, nframes, nblocks);
+}
+
+
+//-------------------------------------------------------------------------
+// synthv1_bench - configuration matrix run.
+//
+
+struct bench_config
+{
+	uint16_t nvoices;
+	uint32_t nframes;
+	int      shape;		// synthv1_wave::Shape
+	bool     bandl;
+	int      slope;		// 0=12dB/oct, 1=24dB/oct, 2=biquad, 3=formant.
+	bool     fx;
+};
+
+
+static const char *s_shape_names[] = { "pulse", "saw", "sine", "rand", "noise" };
+static const char *s_slope_names[] = { "12db", "24db", "biquad", "formant" };
+
+
+// per-block processing cost (usec), given configuration.
+static double bench_config_run ( const bench_config& cfg,
+	float srate, uint32_t nblocks )
+{
+	synthv1_bench synth(cfg.nvoices, srate, cfg.nframes);
+
+	const float shape = float(cfg.shape);
+	const float bandl = (cfg.bandl ? 1.0f : 0.0f);
+	const float slope = float(cfg.slope);
+
+	synth.setParam(synthv1::DCO1_SHAPE1, shape);
+	synth.setParam(synthv1::DCO1_SHAPE2, shape);
+	synth.setParam(synthv1::DCO1_BANDL1, bandl);
+	synth.setParam(synthv1::DCO1_BANDL2, bandl);
+	synth.setParam(synthv1::DCF1_ENABLED, 1.0f);
+	synth.setParam(synthv1::DCF1_SLOPE, slope);
+
+	synth.setParam(synthv1::DCO2_SHAPE1, shape);
+	synth.setParam(synthv1::DCO2_SHAPE2, shape);
+	synth.setParam(synthv1::DCO2_BANDL1, bandl);
+	synth.setParam(synthv1::DCO2_BANDL2, bandl);
+	synth.setParam(synthv1::DCF2_ENABLED, 1.0f);
+	synth.setParam(synthv1::DCF2_SLOPE, slope);
+
+	// whole effects chain, or none at all.
+	const float wet = (cfg.fx ? 0.5f : 0.0f);
+
+	synth.setParam(synthv1::CHO1_WET, wet);
+	synth.setParam(synthv1::FLA1_WET, wet);
+	synth.setParam(synthv1::PHA1_WET, wet);
+	synth.setParam(synthv1::DEL1_WET, wet);
+	synth.setParam(synthv1::REV1_WET, wet);
+	synth.setParam(synthv1::DYN1_COMPRESS, cfg.fx ? 1.0f : 0.0f);
+	synth.setParam(synthv1::DYN1_LIMITER,  cfg.fx ? 1.0f : 0.0f);
+
+	return bench_process(&synth, cfg.nvoices, cfg.nframes, nblocks);
+}
+
+
+// whole matrix; one CSV line per configuration.
+static void bench_matrix ( float srate, float secs, uint16_t nvoices )
+{
+	static const uint16_t s_voices[] = { 1, 8, 32, 128 };
+	const uint16_t nvoices_list = (nvoices > 0 ? 1 : 4);
+
+	::printf("# srate=%g secs=%g\n", srate, secs);
+	::printf("voices,nframes,shape,bandl,slope,fx,"
+		"usec_per_block,ns_per_sample_voice,dsp_load_pct\n");
+
+	bench_config cfg;
+	for (uint16_t v = 0; v < nvoices_list; ++v) {
+		cfg.nvoices = (nvoices > 0 ? nvoices : s_voices[v]);
+		for (cfg.nframes = 16; cfg.nframes <= 4096; cfg.nframes <<= 2) {
+			// same audio length, whatever the block size.
+			uint32_t nblocks = uint32_t(secs * srate) / cfg.nframes;
+			if (nblocks < 8)
+				nblocks = 8;
+			const double block_usecs
+				= 1e6 * double(cfg.nframes) / double(srate);
+			for (cfg.shape = synthv1_wave::Pulse;
+					cfg.shape <= synthv1_wave::Noise; ++cfg.shape) {
+				for (int b = 0; b < 2; ++b) {
+					cfg.bandl = (b > 0);
+					for (cfg.slope = 0; cfg.slope < 4; ++cfg.slope) {
+						for (int f = 0; f < 2; ++f) {
+							cfg.fx = (f > 0);
+							const double usecs
+								= bench_config_run(cfg, srate, nblocks);
+							::printf("%u,%u,%s,%d,%s,%d,%.3f,%.3f,%.2f\n",
+								cfg.nvoices, cfg.nframes,
+								s_shape_names[cfg.shape], int(cfg.bandl),
+								s_slope_names[cfg.slope], int(cfg.fx),
+								usecs,
+								1e3 * usecs / double(cfg.nframes * cfg.nvoices),
+								100.0 * usecs / block_usecs);
+							::fflush(stdout);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------------------------------
+// synthv1_bench - control-rate modulation run.
+//
+
+// in-place radix-2 complex FFT (size must be a power of 2).
+static void bench_fft ( std::complex<double> *x, uint32_t n )
+{
+	for (uint32_t i = 1, j = 0; i < n; ++i) {
+		uint32_t bit = (n >> 1);
+		for ( ; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j)
+			std::swap(x[i], x[j]);
+	}
+
+	for (uint32_t len = 2; len <= n; len <<= 1) {
+		const double a = -2.0 * M_PI / double(len);
+		const std::complex<double> w(::cos(a), ::sin(a));
+		for (uint32_t i = 0; i < n; i += len) {
+			std::complex<double> wk(1.0, 0.0);
+			for (uint32_t k = 0; k < (len >> 1); ++k) {
+				const std::complex<double> u = x[i + k];
+				const std::complex<double> v = x[i + k + (len >> 1)] * wk;
+				x[i + k] = u + v;
+				x[i + k + (len >> 1)] = u - v;
+				wk *= w;
+			}
+		}
+	}
+}
+
+
+// magnitude spectra error, relative to reference (dB).
+static double bench_spectral_error (
+	const std::vector<float>& ref, const std::vector<float>& test )
+{
+	const uint32_t nfft = 4096;
+
+	std::vector<std::complex<double> > x(nfft), y(nfft);
+
+	double err = 0.0;
+	double sum = 0.0;
+
+	for (size_t offs = 0; offs + nfft <= ref.size(); offs += (nfft >> 1)) {
+		for (uint32_t i = 0; i < nfft; ++i) {
+			const double w = 0.5 - 0.5 * ::cos(2.0 * M_PI * double(i) / double(nfft));
+			x[i] = w * ref[offs + i];
+			y[i] = w * test[offs + i];
+		}
+		bench_fft(x.data(), nfft);
+		bench_fft(y.data(), nfft);
+		for (uint32_t i = 0; i <= (nfft >> 1); ++i) {
+			const double d = std::abs(x[i]) - std::abs(y[i]);
+			err += d * d;
+			sum += std::norm(x[i]);
+		}
+	}
+
+	if (err < 1e-30)
+		return -300.0;
+
+	return 10.0 * ::log10(err / (sum > 1e-30 ? sum : 1e-30));
+}
+
+
+// render a modulation heavy chord; per-block cost (usec).
+static double bench_ctl_run ( uint16_t nctl, uint16_t nvoices,
+	float srate, uint32_t nframes, uint32_t nblocks, std::vector<float>& buf )
+{
+	synthv1_bench synth(nvoices, srate, nframes);
+
+	synth.setControlRate(nctl);
+
+	// both synths on the same channel, one voice per note.
+	synth.setParam(synthv1::DEF1_CHANNEL, 1.0f);
+	synth.setParam(synthv1::DEF2_CHANNEL, 1.0f);
+
+	synth.setParam(synthv1::DCO1_RINGMOD, 0.3f);
+	synth.setParam(synthv1::DCF1_ENABLED, 1.0f);
+	synth.setParam(synthv1::DCF1_CUTOFF,  0.4f);
+	synth.setParam(synthv1::DCF1_RESO,    0.6f);
+	synth.setParam(synthv1::LFO1_ENABLED, 1.0f);
+	synth.setParam(synthv1::LFO1_RATE,    0.7f);
+	synth.setParam(synthv1::LFO1_RINGMOD, 0.5f);
+	synth.setParam(synthv1::LFO1_CUTOFF,  0.8f);
+	synth.setParam(synthv1::LFO1_RESO,    0.4f);
+
+	synth.setParam(synthv1::DCO2_RINGMOD, 0.3f);
+	synth.setParam(synthv1::DCF2_ENABLED, 1.0f);
+	synth.setParam(synthv1::DCF2_CUTOFF,  0.6f);
+	synth.setParam(synthv1::DCF2_RESO,    0.3f);
+	synth.setParam(synthv1::LFO2_ENABLED, 1.0f);
+	synth.setParam(synthv1::LFO2_RATE,    0.5f);
+	synth.setParam(synthv1::LFO2_RINGMOD, 0.5f);
+	synth.setParam(synthv1::LFO2_CUTOFF,  0.6f);
+	synth.setParam(synthv1::LFO2_RESO,    0.4f);
+
+	float *ins[2], *outs[2];
+	for (uint16_t k = 0; k < 2; ++k) {
+		ins[k]  = new float [nframes];
+		outs[k] = new float [nframes];
+		::memset(ins[k], 0, nframes * sizeof(float));
+	}
+
+	synth.stabilize();
+
+	for (uint16_t i = 0; i < nvoices && i < 64; ++i) {
+		uint8_t data[3];
+		data[0] = 0x90;
+		data[1] = uint8_t(36 + i);
+		data[2] = 100;
+		synth.process_midi(data, 3);
+	}
+
+	buf.resize(size_t(nframes) * nblocks);
+
+	double usecs = 0.0;
+	for (uint32_t n = 0; n < nblocks; ++n) {
+		const auto t0 = std::chrono::steady_clock::now();
+		synth.process(ins, outs, nframes);
+		const auto t1 = std::chrono::steady_clock::now();
+		usecs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+		::memcpy(&buf[size_t(n) * nframes], outs[0], nframes * sizeof(float));
+	}
+
+	for (uint16_t k = 0; k < 2; ++k) {
+		delete [] outs[k];
+		delete [] ins[k];
+	}
+
+	return usecs / double(nblocks);
+}
+
+
+//-------------------------------------------------------------------------
+// synthv1_bench - oscillator interpolation run.
+//
+
+static const char *s_interp_names[] = { "linear", "cubic", "draft", "polyblep" };
+
+
+// per-block processing cost (usec), given interpolation
+// (or analytic pulse and saw oscillators instead).
+static double bench_interp_run ( synthv1::Interp interp, bool blep,
+	uint16_t nvoices, float srate, uint32_t nframes, uint32_t nblocks )
+{
+	synthv1_bench synth(nvoices, srate, nframes);
+
+	synth.setInterpolation(interp);
+
+	synth.setParam(synthv1::DCO1_POLYBLEP, blep ? 1.0f : 0.0f);
+	synth.setParam(synthv1::DCO2_POLYBLEP, blep ? 1.0f : 0.0f);
+
+	return bench_process(&synth, nvoices, nframes, nblocks);
+}
+
+
+// single note, on a ready instance; power off the harmonics
+// of its fundamental, relative to the one on (dB).
+static double bench_alias ( synthv1_bench *pSynth,
+	int note, float srate, uint32_t nframes )
+{
+	const uint32_t nfft = 65536;
+
+	float *ins[2], *outs[2];
+	for (uint16_t k = 0; k < 2; ++k) {
+		ins[k]  = new float [nframes];
+		outs[k] = new float [nframes];
+		::memset(ins[k], 0, nframes * sizeof(float));
+	}
+
+	pSynth->stabilize();
+
+	// let the new wave tables in, before the note starts
+	// (table selection is set on note-on).
+	for (uint32_t n = 0; n < 4; ++n)
+		pSynth->process(ins, outs, nframes);
+
+	uint8_t data[3];
+	data[0] = 0x90;
+	data[1] = uint8_t(note);
+	data[2] = 100;
+	pSynth->process_midi(data, 3);
+
+	// settle (past the envelope decay) then capture.
+	const uint32_t nsettle = uint32_t(0.5f * srate) / nframes;
+	for (uint32_t n = 0; n < nsettle; ++n)
+		pSynth->process(ins, outs, nframes);
+
+	std::vector<std::complex<double> > x(nfft);
+	for (uint32_t n = 0; n < nfft; n += nframes) {
+		pSynth->process(ins, outs, nframes);
+		for (uint32_t i = 0; i < nframes; ++i) {
+			// 7-term Blackman-Harris window (sidelobes under -180dB).
+			static const double c[] = { 0.27105140069342, 0.43329793923448,
+				0.21812299954311, 0.06592544638803, 0.01081174209837,
+				0.00077658482522, 0.00001388721735 };
+			const double a = 2.0 * M_PI * double(n + i) / double(nfft);
+			double w = c[0];
+			for (int k = 1; k < 7; ++k)
+				w += ((k & 1) ? -c[k] : c[k]) * ::cos(double(k) * a);
+			x[n + i] = w * outs[0][i];
+		}
+	}
+
+	for (uint16_t k = 0; k < 2; ++k) {
+		delete [] outs[k];
+		delete [] ins[k];
+	}
+
+	bench_fft(x.data(), nfft);
+
+	const double f0 = 440.0 * ::pow(2.0, double(note - 69) / 12.0);
+	const double df = double(srate) / double(nfft);
+	const uint32_t nmain = 10; // window main lobe, plus some.
+
+	double on = 0.0;
+	double off = 0.0;
+
+	for (uint32_t i = nmain; i <= (nfft >> 1); ++i) {
+		const double h = double(i) * df / f0;
+		const double d = ::fabs(h - ::round(h)) * f0 / df;
+		if (::round(h) >= 1.0 && d <= double(nmain))
+			on += std::norm(x[i]);
+		else
+			off += std::norm(x[i]);
+	}
+
+	if (off < 1e-30)
+		return -300.0;
+
+	return 10.0 * ::log10(off / (on > 1e-30 ? on : 1e-30));
+}
+
+
+// single high note, plain oscillators only.
+static double bench_interp_alias ( synthv1::Interp interp, bool blep,
+	int shape, float srate )
+{
+	const uint32_t nframes = 256;
+
+	synthv1_bench synth(1, srate, nframes);
+
+	synth.setInterpolation(interp);
+
+	synth.setParam(synthv1::DCO1_SHAPE1, float(shape));
+	synth.setParam(synthv1::DCO1_SHAPE2, float(shape));
+	synth.setParam(synthv1::DCO1_BANDL1, 1.0f);
+	synth.setParam(synthv1::DCO1_BANDL2, 1.0f);
+	synth.setParam(synthv1::DCO1_DETUNE, 0.0f);
+	synth.setParam(synthv1::DCO1_POLYBLEP, blep ? 1.0f : 0.0f);
+	synth.setParam(synthv1::DCF1_ENABLED, 0.0f);
+	synth.setParam(synthv1::LFO1_ENABLED, 0.0f);
+	synth.setParam(synthv1::DYN1_LIMITER, 0.0f);
+
+	return bench_alias(&synth, 96, srate, nframes);
+}
+
+
+//-------------------------------------------------------------------------
+// synthv1_bench - voice oversampling run.
+//
+
+static const char *s_over_names[] = { "1x", "2x", "4x" };
+
+
+// band-limited saws, fully ring modulated, into a resonant 24dB/oct
+// low-pass filter (nonlinear), as the case in point.
+static void bench_over_patch ( synthv1_bench *pSynth, synthv1::Oversample over )
+{
+	pSynth->setOversampling(over);
+
+	pSynth->setParam(synthv1::DCO1_BANDL1, 1.0f);
+	pSynth->setParam(synthv1::DCO1_BANDL2, 1.0f);
+	pSynth->setParam(synthv1::DCO1_RINGMOD, 1.0f);
+	pSynth->setParam(synthv1::DCO1_DETUNE, 0.0f);
+	pSynth->setParam(synthv1::DCF1_ENABLED, 1.0f);
+	pSynth->setParam(synthv1::DCF1_SLOPE, 1.0f);
+	pSynth->setParam(synthv1::DCF1_CUTOFF, 0.9f);
+	pSynth->setParam(synthv1::DCF1_RESO, 0.9f);
+	pSynth->setParam(synthv1::DCF1_ENVELOPE, 0.0f);
+	pSynth->setParam(synthv1::LFO1_ENABLED, 0.0f);
+	pSynth->setParam(synthv1::DYN1_LIMITER, 0.0f);
+}
+
+
+// per-block processing cost (usec), given oversampling.
+static double bench_over_run ( synthv1::Oversample over,
+	uint16_t nvoices, float srate, uint32_t nframes, uint32_t nblocks )
+{
+	synthv1_bench synth(nvoices, srate, nframes);
+
+	bench_over_patch(&synth, over);
+
+	return bench_process(&synth, nvoices, nframes, nblocks);
+}
+
+
+// single high note, given oversampling.
+static double bench_over_alias ( synthv1::Oversample over, float srate )
+{
+	const uint32_t nframes = 256;
+
+	synthv1_bench synth(1, srate, nframes);
+
+	bench_over_patch(&synth, over);
+
+	return bench_alias(&synth, 84, srate, nframes);
+}
+
+
+//-------------------------------------------------------------------------
+// synthv1_bench - fast math accuracy run.
+//
+
+struct bench_fastmath
+{
+	const char *name;
+	float x0, x1;			// domain
+	double bound;			// max. error
+	bool relative;			// relative (else absolute) error
+	double (*ref)(double);
+	float (*fast)(float);
+	synthv1_quad (*fastq)(const synthv1_quad&);
+};
+
+static const bench_fastmath s_fastmath[] = {
+	{ "sin",     -6.2832f, 6.2832f, 2.5e-7, false, ::sin,
+		synthv1_fast_sinf, synthv1_fast_sinf },
+	{ "cos",     -6.2832f, 6.2832f, 2.5e-7, false, ::cos,
+		synthv1_fast_cosf, synthv1_fast_cosf },
+	{ "exp2",    -126.0f,  126.0f,  1.5e-7, true,  ::exp2,
+		synthv1_fast_exp2f, synthv1_fast_exp2f },
+	{ "exp",      -87.0f,   87.0f,  1.5e-7, true,  ::exp,
+		synthv1_fast_expf, synthv1_fast_expf },
+	{ "pow10",    -37.0f,   37.0f,  1.5e-7, true,
+		[](double x) { return ::pow(10.0, x); },
+		synthv1_fast_pow10f, synthv1_fast_pow10f },
+	{ "tanh",     -20.0f,   20.0f,  1.5e-7, false, ::tanh,
+		synthv1_fast_tanhf, synthv1_fast_tanhf },
+	{ "tanh_rel", -0.625f,  0.625f, 1.5e-7, true,  ::tanh,
+		synthv1_fast_tanhf, synthv1_fast_tanhf }
+};
+
+
+// max. error over the domain (scalar and quad flavours),
+// then cost per call (nsec), libm vs. scalar vs. quad (per lane).
+static bool bench_fastmath_run ( const bench_fastmath& fm )
+{
+	const uint32_t npoints = 1 << 20;
+
+	double err = 0.0, errq = 0.0;
+
+	for (uint32_t i = 0; i < npoints; i += 4) {
+		synthv1_quad x;
+		for (uint32_t k = 0; k < 4; ++k)
+			x[k] = fm.x0 + (fm.x1 - fm.x0) * float(i + k) / float(npoints - 1);
+		const synthv1_quad yq = fm.fastq(x);
+		for (uint32_t k = 0; k < 4; ++k) {
+			const double y0 = fm.ref(double(x[k]));
+			const double d0 = (fm.relative && y0 != 0.0 ? ::fabs(y0) : 1.0);
+			const double e  = ::fabs(double(fm.fast(x[k])) - y0) / d0;
+			const double eq = ::fabs(double(yq[k]) - y0) / d0;
+			if (err < e)
+				err = e;
+			if (errq < eq)
+				errq = eq;
+		}
+	}
+
+	// cost per call...
+	const uint32_t nsize = 4096;
+	const uint32_t nruns = 256;
+
+	std::vector<float> xs(nsize);
+	for (uint32_t i = 0; i < nsize; ++i)
+		xs[i] = fm.x0 + (fm.x1 - fm.x0) * float(i) / float(nsize);
+
+	volatile float sink = 0.0f;
+	float acc = 0.0f;
+
+	auto t0 = std::chrono::steady_clock::now();
+	for (uint32_t n = 0; n < nruns; ++n)
+		for (uint32_t i = 0; i < nsize; ++i)
+			acc += float(fm.ref(double(xs[i])));
+	auto t1 = std::chrono::steady_clock::now();
+	const double ns_ref = std::chrono::duration<double, std::nano>(t1 - t0).count();
+
+	t0 = std::chrono::steady_clock::now();
+	for (uint32_t n = 0; n < nruns; ++n)
+		for (uint32_t i = 0; i < nsize; ++i)
+			acc += fm.fast(xs[i]);
+	t1 = std::chrono::steady_clock::now();
+	const double ns_fast = std::chrono::duration<double, std::nano>(t1 - t0).count();
+
+	synthv1_quad accq = synthv1_quad_dup(0.0f);
+	t0 = std::chrono::steady_clock::now();
+	for (uint32_t n = 0; n < nruns; ++n)
+		for (uint32_t i = 0; i < nsize; i += 4)
+			accq += fm.fastq(synthv1_quad_set(xs[i], xs[i + 1], xs[i + 2], xs[i + 3]));
+	t1 = std::chrono::steady_clock::now();
+	const double ns_fastq = std::chrono::duration<double, std::nano>(t1 - t0).count();
+
+	sink = acc + accq[0] + accq[1] + accq[2] + accq[3];
+	(void) sink;
+
+	const double ncalls = double(nruns) * double(nsize);
+	const bool pass = (err < fm.bound && errq < fm.bound);
+
+	::printf("%s,%g,%g,%s,%.3g,%.3g,%.3g,%.2f,%.2f,%.2f,%s\n",
+		fm.name, fm.x0, fm.x1, (fm.relative ? "rel" : "abs"), err, errq,
+		fm.bound, ns_ref / ncalls, ns_fast / ncalls,
+		ns_fastq / ncalls, (pass ? "pass" : "FAIL"));
+
+	return pass;
+}
+
+
+//-------------------------------------------------------------------------
+// synthv1_bench - idle engine run.
+//
+
+// release all voices (as triggered by bench_notes_on).
+static void bench_notes_off ( synthv1 *pSynth, uint16_t nvoices )
+{
+	for (uint16_t i = 0; i < nvoices; ++i) {
+		uint8_t data[3];
+		data[0] = 0x80 | (i < 128 ? 0 : 1);
+		data[1] = uint8_t(i & 0x7f);
+		data[2] = 0;
+		pSynth->process_midi(data, 3);
+	}
+}
+
+
+// per-block processing cost (usec), playing then idle, and the time
+// it takes to go idle after all notes off (secs; negative if never).
+static void bench_idle_run ( bool bfx, uint16_t nvoices,
+	float srate, uint32_t nframes, uint32_t nblocks )
+{
+	synthv1_bench synth(nvoices, srate, nframes);
+
+	// both synths on all channels, so that voices end for good
+	// (a voice only ends when both of its envelopes do).
+	synth.setParam(synthv1::DEF1_CHANNEL, 0.0f);
+	synth.setParam(synthv1::DEF2_CHANNEL, 0.0f);
+
+	if (bfx) {
+		synth.setParam(synthv1::CHO1_WET, 0.5f);
+		synth.setParam(synthv1::FLA1_WET, 0.5f);
+		synth.setParam(synthv1::PHA1_WET, 0.5f);
+		synth.setParam(synthv1::DEL1_WET, 0.5f);
+		synth.setParam(synthv1::REV1_WET, 0.5f);
+	}
+
+	const double usecs_active
+		= bench_process(&synth, nvoices, nframes, nblocks);
+
+	float *ins[2], *outs[2];
+	for (uint16_t k = 0; k < 2; ++k) {
+		ins[k]  = new float [nframes];
+		outs[k] = new float [nframes];
+		::memset(ins[k], 0, nframes * sizeof(float));
+	}
+
+	bench_notes_off(&synth, nvoices);
+
+	// wait for it (up to a minute)...
+	const uint32_t nwait = uint32_t(60.0f * srate) / nframes;
+	uint32_t n = 0;
+	for (; n < nwait && !synth.isIdle(); ++n)
+		synth.process(ins, outs, nframes);
+
+	const double secs_idle = (synth.isIdle()
+		? double(n * nframes) / double(srate) : -1.0);
+
+	const auto t0 = std::chrono::steady_clock::now();
+	for (n = 0; n < nblocks; ++n)
+		synth.process(ins, outs, nframes);
+	const auto t1 = std::chrono::steady_clock::now();
+
+	const double usecs_idle
+		= std::chrono::duration<double, std::micro>(t1 - t0).count()
+		/ double(nblocks);
+
+	for (uint16_t k = 0; k < 2; ++k) {
+		delete [] outs[k];
+		delete [] ins[k];
+	}
+
+	::printf("%s,%.3f,%.3f,%.3f,%.1f\n", (bfx ? "fx" : "dry"),
+		usecs_active, secs_idle, usecs_idle, usecs_active / usecs_idle);
+}
+
+
+//-------------------------------------------------------------------------
+// main.
+//
+
+int main ( int argc, char *argv[] )
+{
+	float    srate   = 48000.0f;
+	uint32_t nframes = 256;
+	uint32_t nblocks = 1000;
+	uint16_t nvoices = 0;
+	float    secs    = 0.25f;
+	bool     bctl    = false;
+	bool     bmatrix = false;
+	bool     binterp = false;
+	bool     bover   = false;
+	bool     bfast   = false;
+	bool     bidle   = false;
+
+	for (int i = 1; i < argc; ++i) {
+		if (::strcmp(argv[i], "-r") == 0 && i < argc - 1)
+			srate = float(::atof(argv[++i]));
+		else
+		if (::strcmp(argv[i], "-n") == 0 && i < argc - 1)
+			nframes = uint32_t(::atoi(argv[++i]));
+		else
+		if (::strcmp(argv[i], "-b") == 0 && i < argc - 1)
+			nblocks = uint32_t(::atoi(argv[++i]));
+		else
+		if (::strcmp(argv[i], "-v") == 0 && i < argc - 1)
+			nvoices = uint16_t(::atoi(argv[++i]));
+		else
+		if (::strcmp(argv[i], "-c") == 0)
+			bctl = true;
+		else
+		if (::strcmp(argv[i], "-m") == 0)
+			bmatrix = true;
+		else
+		if (::strcmp(argv[i], "-i") == 0)
+			binterp = true;
+		else
+		if (::strcmp(argv[i], "-o") == 0)
+			bover = true;
+		else
+		if (::strcmp(argv[i], "-f") == 0)
+			bfast = true;
+		else
+		if (::strcmp(argv[i], "-s") == 0)
+			bidle = true;
+		else
+		if (::strcmp(argv[i], "-t") == 0 && i < argc - 1)
+			secs = float(::atof(argv[++i]));
+		else
+		if (::strcmp(argv[i], "-l") == 0 && i < argc - 1)
+			g_cpu_level = synthv1::CpuLevel(::atoi(argv[++i]));
+		else {
+			::fprintf(stderr, "usage: %s [-r srate] [-n frames] [-b blocks]"
+				" [-l cpulevel] [-c [-v voices]] [-m [-v voices] [-t secs]]"
+				" [-i [-v voices]] [-o [-v voices]] [-f]"
+				" [-s [-v voices]]\n",
+				argv[0]);
+			return 1;
+		}
+	}
+
+	const double block_usecs = 1e6 * double(nframes) / double(srate);
+
+	// fast math approximations, error bounds (fails when exceeded);
+	// no engine instance here, as run on build-time tests...
+	if (bfast) {
+		::printf("func,x0,x1,error,max_error,max_error_quad,bound,"
+			"ns_libm,ns_fast,ns_fast_quad,result\n");
+		bool pass = true;
+		for (const bench_fastmath& fm : s_fastmath)
+			pass = bench_fastmath_run(fm) && pass;
+		return (pass ? 0 : 1);
+	}
+
+	// effective instruction set level...
+	static const char *s_cpu_levels[] = { "auto", "generic", "avx2", "avx512" };
+	const int cpu_level = synthv1_bench(1, srate, nframes).cpuLevel();
+	::printf("# cpu_level=%d (%s)\n", cpu_level, s_cpu_levels[cpu_level]);
+
+	// idle engine, after all notes off...
+	if (bidle) {
+		if (nvoices < 1)
+			nvoices = 32;
+		::printf("# srate=%g nframes=%u nblocks=%u voices=%u\n",
+			srate, nframes, nblocks, nvoices);
+		::printf("effects,usec_per_block,secs_to_idle,"
+			"usec_per_block_idle,idle_speedup\n");
+		bench_idle_run(false, nvoices, srate, nframes, nblocks);
+		bench_idle_run(true, nvoices, srate, nframes, nblocks);
+		return 0;
+	}
+
+	// configuration matrix...
+	if (bmatrix) {
+		bench_matrix(srate, secs, nvoices);
+		return 0;
+	}
+
+	// oscillator interpolation, cost vs. aliasing...
+	if (binterp) {
+		if (nvoices < 1)
+			nvoices = 32;
+		::printf("# srate=%g nframes=%u nblocks=%u voices=%u\n",
+			srate, nframes, nblocks, nvoices);
+		::printf("interp,usec_per_block,relative_cost,"
+			"alias_saw_db,alias_sine_db\n");
+		double usecs0 = 0.0;
+		// (last one, plain linear but with analytic pulse and saw)
+		for (int i = synthv1::InterpLinear; i <= synthv1::InterpDraft + 1; ++i) {
+			const bool blep = (i > synthv1::InterpDraft);
+			const synthv1::Interp interp
+				= (blep ? synthv1::InterpLinear : synthv1::Interp(i));
+			const double usecs = bench_interp_run(interp, blep,
+				nvoices, srate, nframes, nblocks);
+			if (usecs0 < 1e-9)
+				usecs0 = usecs;
+			const double alias_saw
+				= bench_interp_alias(interp, blep, synthv1_wave::Saw, srate);
+			const double alias_sine
+				= bench_interp_alias(interp, blep, synthv1_wave::Sine, srate);
+			::printf("%s,%.3f,%.3f,%.2f,%.2f\n", s_interp_names[i],
+				usecs, usecs / usecs0, alias_saw, alias_sine);
+		}
+		return 0;
+	}
+
+	// voice oversampling, cost vs. aliasing...
+	if (bover) {
+		if (nvoices < 1)
+			nvoices = 32;
+		::printf("# srate=%g nframes=%u nblocks=%u voices=%u\n",
+			srate, nframes, nblocks, nvoices);
+		::printf("over,usec_per_block,relative_cost,alias_db\n");
+		double usecs0 = 0.0;
+		for (int i = synthv1::Oversample1x; i <= synthv1::Oversample4x; ++i) {
+			const synthv1::Oversample over = synthv1::Oversample(i);
+			const double usecs
+				= bench_over_run(over, nvoices, srate, nframes, nblocks);
+			if (usecs0 < 1e-9)
+				usecs0 = usecs;
+			const double alias = bench_over_alias(over, srate);
+			::printf("%s,%.3f,%.3f,%.2f\n", s_over_names[i],
+				usecs, usecs / usecs0, alias);
+		}
+		return 0;
+	}
+
+	// control-rate vs. per sample modulation...
+	if (bctl) {
+		if (nvoices < 1)
+			nvoices = 32;
+		::printf("# srate=%g nframes=%u nblocks=%u voices=%u\n",
+			srate, nframes, nblocks, nvoices);
+		::printf("ctl_frames,usec_per_block,speedup,spectral_error_db\n");
+		std::vector<float> ref, test;
+		const double usecs0
+			= bench_ctl_run(0, nvoices, srate, nframes, nblocks, ref);
+		::printf("0,%.3f,1.000,-inf\n", usecs0);
+		for (uint16_t nctl = 8; nctl <= 64; nctl <<= 1) {
+			const double usecs
+				= bench_ctl_run(nctl, nvoices, srate, nframes, nblocks, test);
+			::printf("%u,%.3f,%.3f,%.2f\n", nctl, usecs, usecs0 / usecs,
+				bench_spectral_error(ref, test));
+		}
+		return 0;
+	}
+
+	::printf("# srate=%g nframes=%u nblocks=%u\n", srate, nframes, nblocks);
+	::printf("voices,usec_per_block,ns_per_sample_voice,dsp_load_pct\n");
+
+	for (uint16_t nvoices = 1; nvoices <= 256; nvoices <<= 1) {
+		const double usecs = bench_run(nvoices, srate, nframes, nblocks);
+		::printf("%u,%.3f,%.3f,%.2f\n", nvoices, usecs,
+			1e3 * usecs / double(nframes * nvoices),
+			100.0 * usecs / block_usecs);
+	}
+
+	return 0;
+}
+
+
+// end of synthv1_bench.cpp
@@ -41,6 +41,28 @@ synthv1_config *synthv1_config::getInstance (void)
 }
 
 
+// Engine default polyphony, as configured (static).
+int synthv1_config::defaultPolyphony (void)
+{
+	int iPolyphony = 0;
+
+	if (g_pSettings) {
+		iPolyphony = g_pSettings->iPolyphony;
+	} else {
+		QSettings settings(PROJECT_DOMAIN, PROJECT_NAME);
+		iPolyphony = settings.value("/Engine/Polyphony", 64).toInt();
+	}
+
+	if (iPolyphony < 1)
+		iPolyphony = 64;
+	else
+	if (iPolyphony > 256)
+		iPolyphony = 256;
+
+	return iPolyphony;
+}
+
+
 // Constructor.
 synthv1_config::synthv1_config (void)
 	: QSettings(PROJECT_DOMAIN, PROJECT_NAME)
@@ -527,6 +549,19 @@ void synthv1_config::load (void)
 	sCustomStyleTheme = QSettings::value("/StyleTheme").toString();
 	QSettings::endGroup();
 
+	// Engine options.
+	QSettings::beginGroup("/Engine");
+	iPolyphony = QSettings::value("/Polyphony", 64).toInt();
+	iVoiceThreads = QSettings::value("/VoiceThreads", 0).toInt();
+	iVoiceSteal = QSettings::value("/VoiceSteal", 0).toInt();
+	iControlRate = QSettings::value("/ControlRate", 0).toInt();
+	iCpuLevel = QSettings::value("/CpuLevel", 0).toInt();
+	iInterpolation = QSettings::value("/Interpolation", 0).toInt();
+	iOversampling = QSettings::value("/Oversampling", 0).toInt();
+	bWidthMorph = QSettings::value("/WidthMorph", false).toBool();
+	bFxPipeline = QSettings::value("/FxPipeline", false).toBool();
+	QSettings::endGroup();
+
 	// Micro-tuning options.
 	QSettings::beginGroup("/Tuning");
 	bTuningEnabled = QSettings::value("/Enabled", false).toBool();
@@ -570,6 +605,19 @@ void synthv1_config::save (void)
 	QSettings::setValue("/StyleTheme", sCustomStyleTheme);
 	QSettings::endGroup();
 
+	// Engine options.
+	QSettings::beginGroup("/Engine");
+	QSettings::setValue("/Polyphony", iPolyphony);
+	QSettings::setValue("/VoiceThreads", iVoiceThreads);
+	QSettings::setValue("/VoiceSteal", iVoiceSteal);
+	QSettings::setValue("/ControlRate", iControlRate);
+	QSettings::setValue("/CpuLevel", iCpuLevel);
+	QSettings::setValue("/Interpolation", iInterpolation);
+	QSettings::setValue("/Oversampling", iOversampling);
+	QSettings::setValue("/WidthMorph", bWidthMorph);
+	QSettings::setValue("/FxPipeline", bFxPipeline);
+	QSettings::endGroup();
+
 	// Micro-tuning options.
 	QSettings::beginGroup("/Tuning");
 	QSettings::setValue("/Enabled", bTuningEnabled);
@@ -73,6 +73,23 @@ public:
 	QString sCustomColorTheme;
 	QString sCustomStyleTheme;
 
+	// Engine options (polyphony; parallel voice rendering threads, 0 = none;
+	// voice stealing policy, 0 = none; control-rate period, 0 = per sample;
+	// DSP kernels instruction set level, 0 = auto-detect;
+	// oscillator interpolation, 0 = linear, 1 = cubic, 2 = draft;
+	// voice oversampling, 0 = none, 1 = 2x, 2 = 4x;
+	// oscillator width morphing, off = regenerate on width change;
+	// effects chain pipelined on a helper thread, one period latency).
+	int iPolyphony;
+	int iVoiceThreads;
+	int iVoiceSteal;
+	int iControlRate;
+	int iCpuLevel;
+	int iInterpolation;
+	int iOversampling;
+	bool bWidthMorph;
+	bool bFxPipeline;
+
 	// Micro-tuning options.
 	bool    bTuningEnabled;
 	float   fTuningRefPitch;
@@ -88,6 +105,9 @@ public:
 	// Singleton instance accessor.
 	static synthv1_config *getInstance();
 
+	// Engine default polyphony, as configured.
+	static int defaultPolyphony();
+
 	// Preset utility methods.
 	QString presetFile(const QString& sPreset);
 	void setPresetFile(const QString& sPreset, const QString& sPresetFile);
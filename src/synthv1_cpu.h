@@ -0,0 +1,72 @@
+// synthv1_cpu.h
+//
+/****************************************************************************
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __synthv1_cpu_h
+#define __synthv1_cpu_h
+
+#include "synthv1.h"
+
+
+//-------------------------------------------------------------------------
+// synthv1_cpu - runtime CPU dispatch helpers (x86 only, GCC/Clang).
+//
+// hot DSP kernels get extra clones compiled for wider instruction sets
+// (function target attributes), one of which is picked at run-time.
+
+#if defined(CONFIG_CPU_DISPATCH) && defined(__GNUC__) \
+	&& (defined(__x86_64__) || defined(__i386__))
+#define SYNTHV1_CPU_DISPATCH 1
+#define SYNTHV1_TARGET_AVX2   __attribute__((target("avx2")))
+#define SYNTHV1_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+
+// best instruction set level supported by the running CPU (and OS).
+
+inline synthv1::CpuLevel synthv1_cpu_detect (void)
+{
+#ifdef SYNTHV1_CPU_DISPATCH
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return synthv1::CpuAVX512;
+	if (__builtin_cpu_supports("avx2"))
+		return synthv1::CpuAVX2;
+#endif
+	return synthv1::CpuGeneric;
+}
+
+
+// effective instruction set level, as requested (auto = best detected).
+
+inline synthv1::CpuLevel synthv1_cpu_level ( synthv1::CpuLevel level )
+{
+	const synthv1::CpuLevel detected = synthv1_cpu_detect();
+
+	if (level <= synthv1::CpuAuto || level > detected)
+		level = detected;
+
+	return level;
+}
+
+
+#endif	// __synthv1_cpu_h
+
+// end of synthv1_cpu.h
@@ -0,0 +1,351 @@
+// synthv1_fastmath.h
+//
+/****************************************************************************
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __synthv1_fastmath_h
+#define __synthv1_fastmath_h
+
+#include "synthv1_quad.h"
+
+#include <cstdint>
+#include <cstring>
+
+
+//-------------------------------------------------------------------------
+// synthv1_fastmath - polynomial approximations of a few elementary
+// functions, for filter coefficients (re)computed at audio rate.
+//
+// every function comes in a scalar and a quad (four lanes) flavour, the
+// latter branch-free, both sharing the very same polynomials. error
+// bounds below are as measured against the double precision libm, over
+// the given domains, as built with -ffast-math (synthv1_bench -f):
+//
+//   synthv1_fast_sinf, _cosf, _sincosf  |x| <= 2pi    abs. error < 2.5e-7 (*)
+//   synthv1_fast_exp2f                  |x| <= 126    rel. error < 1.5e-7
+//   synthv1_fast_expf                   |x| <= 87     rel. error < 1.5e-7 (**)
+//   synthv1_fast_pow10f                 |x| <= 37     rel. error < 1.5e-7 (**)
+//   synthv1_fast_tanhf                  any x         abs. error < 1.5e-7
+//                                       |x| < 0.625   rel. error < 1.5e-7
+//
+//   (*)  range reduction is by quadrants (pi/2), in two parts; the
+//        optimizer may fold those back into one, so the error grows
+//        with |x|, some 5e-8 per quadrant; filters only need [0, pi].
+//   (**) range reduction is by log(2) (Cody-Waite), the high part
+//        being an exact integer product, so that the optimizer can't
+//        fold the two parts back into one; the argument scaling (to
+//        base 2) then only applies to the reduced argument.
+//
+// nb. -ffast-math is on for the whole build, so range reduction only
+// uses plain truncation to integer, no rounding tricks the optimizer
+// would be free to fold away.
+
+
+// scalar bit cast.
+
+inline float synthv1_float_from_bits ( const int32_t i )
+{
+	float x; ::memcpy(&x, &i, sizeof(x)); return x;
+}
+
+
+// polynomial kernels (scalar or quad alike).
+
+namespace synthv1_fastmath {
+
+// sin(r), r in [-pi/4, pi/4] (odd Taylor series to r^9).
+template <typename T>
+inline T sin_poly ( const T& r )
+{
+	const T r2 = r * r;
+	return r + r * r2 * (-1.6666667e-1f + r2 * (8.3333333e-3f
+		+ r2 * (-1.9841270e-4f + r2 * 2.7557319e-6f)));
+}
+
+// cos(r), r in [-pi/4, pi/4] (even Taylor series to r^10).
+template <typename T>
+inline T cos_poly ( const T& r )
+{
+	const T r2 = r * r;
+	return 1.0f + r2 * (-0.5f + r2 * (4.1666667e-2f + r2 * (-1.3888889e-3f
+		+ r2 * (2.4801587e-5f + r2 * -2.7557319e-7f))));
+}
+
+// 2^f, f in [-0.5, 0.5] (Cephes exp2f minimax).
+template <typename T>
+inline T exp2_poly ( const T& f )
+{
+	return 1.0f + f * (6.931472028550421e-1f + f * (2.402264791363012e-1f
+		+ f * (5.550332471162809e-2f + f * (9.618437357674640e-3f
+		+ f * (1.339887440266574e-3f + f * 1.535336188319500e-4f)))));
+}
+
+// tanh(x), |x| < 0.625 (Cephes tanhf minimax).
+template <typename T>
+inline T tanh_poly ( const T& x )
+{
+	const T x2 = x * x;
+	return x + x * x2 * (-3.33332819422e-1f + x2 * (1.33314422036e-1f
+		+ x2 * (-5.37397155531e-2f + x2 * (2.06390887954e-2f
+		+ x2 * -5.70498872745e-3f))));
+}
+
+// range reduction constants.
+const float TWO_OVER_PI = 6.3661977e-1f;
+const float PI_2_HI     = 1.5703125f;		// (exact, 9 bits)
+const float PI_2_LO     = 4.8382679e-4f;
+const float LOG2_E      = 1.4426950f;
+const float LOG2_10     = 3.3219281f;
+
+// log(2) and log10(2), split in two parts (Cody-Waite):
+// high part is an integer times LOG2_HI_SCALE, its products
+// by an exponent (|n| <= 127) still exact in 24 bits; low part
+// goes pre-scaled by the respective base 2 log.
+const float   LOG2_HI_SCALE = 1.52587890625e-5f;	// (2^-16)
+const int32_t LN2_HI        = 45426;
+const float   LN2_LO        = 2.0610440e-6f;		// (1.4286068e-6 * LOG2_E)
+const int32_t LOG10_2_HI    = 19728;
+const float   LOG10_2_LO    = 1.5297608e-5f;		// (4.6050390e-6 * LOG2_10)
+
+// argument ranges, as 2^x with x in [-126, 127].
+const float EXP_MIN     = -87.336544f;
+const float EXP_MAX     =  88.029692f;
+const float POW10_MIN   = -37.929779f;
+const float POW10_MAX   =  38.230809f;
+
+// quadrant bias, keeps truncation a floor (multiple of 4).
+const float QUADRANT_BIAS = 4096.0f;
+
+} // namespace synthv1_fastmath
+
+
+//-------------------------------------------------------------------------
+// scalar flavour.
+
+inline void synthv1_fast_sincosf ( const float x, float& s, float& c )
+{
+	using namespace synthv1_fastmath;
+
+	const int32_t k = int32_t(x * TWO_OVER_PI + (QUADRANT_BIAS + 0.5f));
+	const float q = float(k) - QUADRANT_BIAS;
+	const float r = (x - q * PI_2_HI) - q * PI_2_LO;
+
+	const float s0 = sin_poly(r);
+	const float c0 = cos_poly(r);
+
+	// quadrant swap and signs
+	const float s1 = (k & 1 ? c0 : s0);
+	const float c1 = (k & 1 ? s0 : c0);
+	s = (k & 2 ? -s1 : s1);
+	c = ((k + 1) & 2 ? -c1 : c1);
+}
+
+inline float synthv1_fast_sinf ( const float x )
+{
+	float s, c;
+	synthv1_fast_sincosf(x, s, c);
+	return s;
+}
+
+inline float synthv1_fast_cosf ( const float x )
+{
+	float s, c;
+	synthv1_fast_sincosf(x, s, c);
+	return c;
+}
+
+
+inline float synthv1_fast_exp2f ( float x )
+{
+	using namespace synthv1_fastmath;
+
+	if (x < -126.0f)
+		x = -126.0f;
+	else
+	if (x > 127.0f)
+		x = 127.0f;
+
+	// (biased exponent, in [1, 254])
+	const int32_t k = int32_t(x + 127.5f);
+	const float f = x - float(k - 127);
+
+	return exp2_poly(f) * synthv1_float_from_bits(k << 23);
+}
+
+// b^x, as 2^n 2^f, n integer and f = (x - n log_b(2)) log2(b).
+inline float synthv1_fast_exp2f_cw ( float x, const float xmin,
+	const float xmax, const float log2b, const int32_t hi, const float lo )
+{
+	using namespace synthv1_fastmath;
+
+	if (x < xmin)
+		x = xmin;
+	else
+	if (x > xmax)
+		x = xmax;
+
+	// (biased exponent, in [1, 254])
+	const int32_t k = int32_t(x * log2b + 127.5f);
+	const int32_t n = k - 127;
+	const float r = x - float(n * hi) * LOG2_HI_SCALE;
+	const float f = r * log2b - float(n) * lo;
+
+	return exp2_poly(f) * synthv1_float_from_bits(k << 23);
+}
+
+inline float synthv1_fast_expf ( const float x )
+{
+	using namespace synthv1_fastmath;
+
+	return synthv1_fast_exp2f_cw(x,
+		EXP_MIN, EXP_MAX, LOG2_E, LN2_HI, LN2_LO);
+}
+
+inline float synthv1_fast_pow10f ( const float x )
+{
+	using namespace synthv1_fastmath;
+
+	return synthv1_fast_exp2f_cw(x,
+		POW10_MIN, POW10_MAX, LOG2_10, LOG10_2_HI, LOG10_2_LO);
+}
+
+
+inline float synthv1_fast_tanhf ( const float x )
+{
+	using namespace synthv1_fastmath;
+
+	const float a = (x < 0.0f ? -x : x);
+	if (a < 0.625f)
+		return tanh_poly(x);
+
+	const float t = 1.0f - 2.0f / (synthv1_fast_exp2f(2.0f * LOG2_E * a) + 1.0f);
+	return (x < 0.0f ? -t : t);
+}
+
+
+//-------------------------------------------------------------------------
+// quad flavour.
+
+inline void synthv1_fast_sincosf (
+	const synthv1_quad& x, synthv1_quad& s, synthv1_quad& c )
+{
+	using namespace synthv1_fastmath;
+
+	const synthv1_quadi k = __builtin_convertvector(
+		x * TWO_OVER_PI + (QUADRANT_BIAS + 0.5f), synthv1_quadi);
+	const synthv1_quad q = __builtin_convertvector(k, synthv1_quad)
+		- QUADRANT_BIAS;
+	const synthv1_quad r = (x - q * PI_2_HI) - q * PI_2_LO;
+
+	const synthv1_quad s0 = sin_poly(r);
+	const synthv1_quad c0 = cos_poly(r);
+
+	// quadrant swap and signs
+	const synthv1_quadi odd = ((k & 1) != 0);
+	const synthv1_quad s1 = synthv1_quad_select(odd, c0, s0);
+	const synthv1_quad c1 = synthv1_quad_select(odd, s0, c0);
+	const synthv1_quadi sign_s = -((k >> 1) & 1) & INT32_MIN;
+	const synthv1_quadi sign_c = -(((k + 1) >> 1) & 1) & INT32_MIN;
+	s = synthv1_quad_from_bits(synthv1_quad_bits(s1) ^ sign_s);
+	c = synthv1_quad_from_bits(synthv1_quad_bits(c1) ^ sign_c);
+}
+
+inline synthv1_quad synthv1_fast_sinf ( const synthv1_quad& x )
+{
+	synthv1_quad s, c;
+	synthv1_fast_sincosf(x, s, c);
+	return s;
+}
+
+inline synthv1_quad synthv1_fast_cosf ( const synthv1_quad& x )
+{
+	synthv1_quad s, c;
+	synthv1_fast_sincosf(x, s, c);
+	return c;
+}
+
+
+inline synthv1_quad synthv1_fast_exp2f ( const synthv1_quad& x )
+{
+	using namespace synthv1_fastmath;
+
+	const synthv1_quad y = synthv1_quad_clamp(x, -126.0f, 127.0f);
+
+	// (biased exponents, in [1, 254])
+	const synthv1_quadi k = __builtin_convertvector(y + 127.5f, synthv1_quadi);
+	const synthv1_quad f = y - __builtin_convertvector(k - 127, synthv1_quad);
+
+	return exp2_poly(f) * synthv1_quad_from_bits(k << 23);
+}
+
+inline synthv1_quad synthv1_fast_exp2f_cw ( const synthv1_quad& x,
+	const float xmin, const float xmax,
+	const float log2b, const int32_t hi, const float lo )
+{
+	using namespace synthv1_fastmath;
+
+	const synthv1_quad y = synthv1_quad_clamp(x, xmin, xmax);
+
+	// (biased exponents, in [1, 254])
+	const synthv1_quadi k = __builtin_convertvector(
+		y * log2b + 127.5f, synthv1_quadi);
+	const synthv1_quadi n = k - 127;
+	const synthv1_quad r = y
+		- __builtin_convertvector(n * hi, synthv1_quad) * LOG2_HI_SCALE;
+	const synthv1_quad f = r * log2b
+		- __builtin_convertvector(n, synthv1_quad) * lo;
+
+	return exp2_poly(f) * synthv1_quad_from_bits(k << 23);
+}
+
+inline synthv1_quad synthv1_fast_expf ( const synthv1_quad& x )
+{
+	using namespace synthv1_fastmath;
+
+	return synthv1_fast_exp2f_cw(x,
+		EXP_MIN, EXP_MAX, LOG2_E, LN2_HI, LN2_LO);
+}
+
+inline synthv1_quad synthv1_fast_pow10f ( const synthv1_quad& x )
+{
+	using namespace synthv1_fastmath;
+
+	return synthv1_fast_exp2f_cw(x,
+		POW10_MIN, POW10_MAX, LOG2_10, LOG10_2_HI, LOG10_2_LO);
+}
+
+
+inline synthv1_quad synthv1_fast_tanhf ( const synthv1_quad& x )
+{
+	using namespace synthv1_fastmath;
+
+	const synthv1_quadi sign = synthv1_quad_bits(x) & INT32_MIN;
+	const synthv1_quad a = synthv1_quad_from_bits(synthv1_quad_bits(x) ^ sign);
+
+	const synthv1_quad t = 1.0f
+		- 2.0f / (synthv1_fast_exp2f(2.0f * LOG2_E * a) + 1.0f);
+
+	return synthv1_quad_select(a < 0.625f, tanh_poly(x),
+		synthv1_quad_from_bits(synthv1_quad_bits(t) ^ sign));
+}
+
+
+#endif	// __synthv1_fastmath_h
+
+// end of synthv1_fastmath.h
@@ -1,7 +1,7 @@
 // synthv1_filter.h
 //
 /****************************************************************************
-   Copyright (C) 2012-2021, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -22,6 +22,9 @@
 #ifndef __synthv1_filter_h
 #define __synthv1_filter_h
 
+#include "synthv1_quad.h"
+#include "synthv1_fastmath.h"
+
 #include <cstdint>
 #include <cstdlib>
 #include <cmath>
@@ -215,15 +218,20 @@ public:
 		return out;
 	}
 
-protected:
+	// filter coeffs (b0/a0, b1/a0, b2/a0, a1/a0, a2/a0)
+	static void coeffs(Type type, float cutoff, float reso, float *c)
+	{
+		float tsin, tcos;
+		synthv1_fast_sincosf(float(M_PI) * cutoff, tsin, tcos);
 
-	void reset()
+		coeffs(type, tsin, tcos, reso, c);
+	}
+
+	// filter coeffs, given sine and cosine of omega (pi * cutoff)
+	static void coeffs(Type type, float tsin, float tcos, float reso, float *c)
 	{
-		const float q = 2.0f * m_reso * m_reso + 1.0f;
+		const float q = 2.0f * reso * reso + 1.0f;
 
-		const float omega = M_PI * m_cutoff;
-		const float tsin  = ::sinf(omega);
-		const float tcos  = ::cosf(omega);
 		const float alpha = tsin / (2.0f * q);
 
 		// temp vars
@@ -233,7 +241,7 @@ protected:
 
 		float b0, b1, b2;
 
-		switch (m_type) {
+		switch (type) {
 		case Notch:
 			b0 =  1.0f;
 			b1 = -2.0f * tcos;
@@ -257,12 +265,27 @@ protected:
 			break;
 		}
 
+		c[0] = b0 / a0;
+		c[1] = b1 / a0;
+		c[2] = b2 / a0;
+		c[3] = a1 / a0;
+		c[4] = a2 / a0;
+	}
+
+protected:
+
+	void reset()
+	{
+		float c[5];
+
+		coeffs(m_type, m_cutoff, m_reso, c);
+
 		// set filter coeffs
-		m_b0a0 = b0 / a0;
-		m_b1a0 = b1 / a0;
-		m_b2a0 = b2 / a0;
-		m_a1a0 = a1 / a0;
-		m_a2a0 = a2 / a0;
+		m_b0a0 = c[0];
+		m_b1a0 = c[1];
+		m_b2a0 = c[2];
+		m_a1a0 = c[3];
+		m_a2a0 = c[4];
 	}
 
 private:
@@ -282,6 +305,346 @@ private:
 };
 
 
+//-------------------------------------------------------------------------
+// synthv1_filter1_quad - four lanes of synthv1_filter1 at once.
+//
+
+class synthv1_filter1_quad
+{
+public:
+
+	synthv1_filter1_quad(uint16_t nover = 2) : m_nover(nover)
+		{ for (uint16_t i = 0; i < 4; ++i) reset(i); }
+
+	void reset(uint16_t i, synthv1_filter1::Type type = synthv1_filter1::Low)
+	{
+		m_low[i]   = 0.0f;
+		m_band[i]  = 0.0f;
+		m_high[i]  = 0.0f;
+		m_notch[i] = 0.0f;
+
+		// output lane selectors
+		m_wlow[i]   = 0.0f;
+		m_wband[i]  = 0.0f;
+		m_whigh[i]  = 0.0f;
+		m_wnotch[i] = 0.0f;
+
+		switch (type) {
+		case synthv1_filter1::Notch:
+			m_wnotch[i] = 1.0f;
+			break;
+		case synthv1_filter1::High:
+			m_whigh[i] = 1.0f;
+			break;
+		case synthv1_filter1::Band:
+			m_wband[i] = 1.0f;
+			break;
+		case synthv1_filter1::Low:
+		default:
+			m_wlow[i] = 1.0f;
+			break;
+		}
+	}
+
+	synthv1_quad output(
+		const synthv1_quad& in, const synthv1_quad& cutoff, const synthv1_quad& reso)
+	{
+		const synthv1_quad q = (1.0f - reso);
+
+		for (uint16_t i = 0; i < m_nover; ++i) {
+			m_low  += cutoff * m_band;
+			m_high  = in - m_low - q * m_band;
+			m_band += cutoff * m_high;
+			m_notch = m_high + m_low;
+		}
+
+		return m_wlow * m_low + m_wband * m_band
+			+ m_whigh * m_high + m_wnotch * m_notch;
+	}
+
+private:
+
+	uint16_t m_nover;
+
+	synthv1_quad m_low;
+	synthv1_quad m_band;
+	synthv1_quad m_high;
+	synthv1_quad m_notch;
+
+	synthv1_quad m_wlow, m_wband, m_whigh, m_wnotch;
+};
+
+
+//-------------------------------------------------------------------------
+// synthv1_filter2_quad - four lanes of synthv1_filter2 at once.
+//
+
+class synthv1_filter2_quad
+{
+public:
+
+	synthv1_filter2_quad()
+		{ for (uint16_t i = 0; i < 4; ++i) reset(i); }
+
+	void reset(uint16_t i, synthv1_filter2::Type type = synthv1_filter2::Low)
+	{
+		m_b0[i] = m_b1[i] = m_b2[i] = m_b3[i] = m_b4[i] = 0.0f;
+
+		// output lane selectors
+		m_wlow[i]  = 0.0f;
+		m_wband[i] = 0.0f;
+		m_whigh[i] = 0.0f;
+		m_win[i]   = 0.0f;
+
+		switch (type) {
+		case synthv1_filter2::Notch:
+			m_wband[i] = 1.0f;
+			m_win[i] = -1.0f;
+			break;
+		case synthv1_filter2::High:
+			m_whigh[i] = 1.0f;
+			break;
+		case synthv1_filter2::Band:
+			m_wband[i] = 1.0f;
+			break;
+		case synthv1_filter2::Low:
+		default:
+			m_wlow[i] = 1.0f;
+			break;
+		}
+	}
+
+	synthv1_quad output(
+		const synthv1_quad& x, const synthv1_quad& cutoff, const synthv1_quad& reso)
+	{
+		const synthv1_quad c = 1.0f - cutoff;
+		const synthv1_quad p = cutoff + 0.8f * cutoff * c;
+		const synthv1_quad f = p + p - 1.0f;
+		const synthv1_quad q = reso * (1.0f + 0.5f * c * (1.0f - c + 5.6f * c * c));
+
+		const synthv1_quad in = x - q * m_b4; // feedback
+
+		synthv1_quad t1, t2;
+
+		t1 = m_b1; m_b1 = (in   + m_b0) * p - m_b1 * f;
+		t2 = m_b2; m_b2 = (m_b1 + t1) * p - m_b2 * f;
+		t1 = m_b3; m_b3 = (m_b2 + t2) * p - m_b3 * f;
+
+		m_b4 = (m_b3 + t1) * p - m_b4 * f;
+		m_b4 = m_b4 - m_b4 * m_b4 * m_b4 * 0.166667f; // clipping
+
+		m_b0 = in;
+
+		return m_wlow * m_b4 + m_wband * (3.0f * (m_b3 - m_b4))
+			+ m_whigh * (in - m_b4) + m_win * in;
+	}
+
+private:
+
+	synthv1_quad m_b0, m_b1, m_b2, m_b3, m_b4;
+
+	synthv1_quad m_wlow, m_wband, m_whigh, m_win;
+};
+
+
+//-------------------------------------------------------------------------
+// synthv1_filter3_quad - four lanes of synthv1_filter3 at once.
+//
+
+class synthv1_filter3_quad
+{
+public:
+
+	synthv1_filter3_quad()
+	{
+		m_cutoff = synthv1_quad_dup(0.5f);
+		m_reso = synthv1_quad_dup(0.0f);
+
+		for (uint16_t i = 0; i < 4; ++i)
+			reset(i);
+	}
+
+	void reset(uint16_t i, synthv1_filter3::Type type = synthv1_filter3::Low)
+	{
+		m_type[i] = type;
+
+		m_out1[i] = m_out2[i] = 0.0f;
+		m_in1[i] = m_in2[i] = 0.0f;
+
+		reset_coeffs(i);
+	}
+
+	// (coefficients are only tracked for the lanes in mask)
+	synthv1_quad output(
+		const synthv1_quad& in, const synthv1_quad& cutoff, const synthv1_quad& reso,
+		uint16_t mask = 0x0f)
+	{
+		// parameter changes (per lane)
+		uint16_t changed = 0;
+		for (uint16_t i = 0; i < 4; ++i) {
+			if ((mask & (1 << i)) == 0)
+				continue;
+			if (::fabsf(m_cutoff[i] - cutoff[i]) > 0.001f ||
+				::fabsf(m_reso[i]   - reso[i])   > 0.001f) {
+				m_cutoff[i] = cutoff[i];
+				m_reso[i] = reso[i];
+				changed |= (1 << i);
+			}
+		}
+
+		// (omega sine and cosine, all lanes at once)
+		if (changed) {
+			synthv1_quad tsin, tcos;
+			synthv1_fast_sincosf(float(M_PI) * m_cutoff, tsin, tcos);
+			for (uint16_t i = 0; i < 4; ++i) {
+				if (changed & (1 << i))
+					reset_coeffs(i, tsin[i], tcos[i]);
+			}
+		}
+
+		// filter
+		const synthv1_quad out = m_b0a0 * in
+			+ m_b1a0 * m_in1  + m_b2a0 * m_in2
+			- m_a1a0 * m_out1 - m_a2a0 * m_out2;
+
+		// push in/out buffers
+		m_in2  = m_in1;
+		m_in1  = in;
+		m_out2 = m_out1;
+		m_out1 = out;
+
+		// return output
+		return out;
+	}
+
+protected:
+
+	void reset_coeffs(uint16_t i)
+	{
+		float tsin, tcos;
+		synthv1_fast_sincosf(float(M_PI) * m_cutoff[i], tsin, tcos);
+
+		reset_coeffs(i, tsin, tcos);
+	}
+
+	void reset_coeffs(uint16_t i, float tsin, float tcos)
+	{
+		float c[5];
+
+		synthv1_filter3::coeffs(m_type[i], tsin, tcos, m_reso[i], c);
+
+		m_b0a0[i] = c[0];
+		m_b1a0[i] = c[1];
+		m_b2a0[i] = c[2];
+		m_a1a0[i] = c[3];
+		m_a2a0[i] = c[4];
+	}
+
+private:
+
+	// filter type (per lane)
+	synthv1_filter3::Type m_type[4];
+
+	// filter params
+	synthv1_quad m_cutoff;
+	synthv1_quad m_reso;
+
+	// filter coeffs
+	synthv1_quad m_b0a0, m_b1a0, m_b2a0, m_a1a0, m_a2a0;
+
+	// in/out history
+	synthv1_quad m_out1, m_out2, m_in1, m_in2;
+};
+
+
+//-------------------------------------------------------------------------
+// synthv1_halfband_quad - polyphase half-band decimator (by 2), over
+// four lanes at once; a linear phase FIR of 4M-1 taps, every other one
+// but the centre being zero, so the even phase is just a pure delay.
+//
+
+template <uint16_t M>
+class synthv1_halfband_quad
+{
+public:
+
+	synthv1_halfband_quad() : m_iodd(0), m_ieven(0)
+		{ for (uint16_t i = 0; i < 4; ++i) reset(i); }
+
+	void reset(uint16_t i)
+	{
+		for (uint16_t n = 0; n < (M << 2); ++n)
+			m_odd[n][i] = 0.0f;
+		for (uint16_t n = 0; n < M - 1; ++n)
+			m_even[n][i] = 0.0f;
+	}
+
+	// two input frames (oldest first), one output frame.
+	synthv1_quad output(const synthv1_quad& x0, const synthv1_quad& x1)
+	{
+		// odd phase history, newest first (doubled up, read in one go)
+		m_iodd = (m_iodd > 0 ? m_iodd : (M << 1)) - 1;
+		m_odd[m_iodd] = m_odd[m_iodd + (M << 1)] = x1;
+
+		const float *c = coeffs();
+		const synthv1_quad *h = &m_odd[m_iodd];
+
+		synthv1_quad y = 0.5f * m_even[m_ieven];
+		for (uint16_t k = 1; k <= M; ++k)
+			y += c[k - 1] * (h[M - k] + h[M + k - 1]);
+
+		// even phase, delayed by M-1 frames (centre tap)
+		m_even[m_ieven] = x0;
+		if (++m_ieven >= M - 1)
+			m_ieven = 0;
+
+		return y;
+	}
+
+protected:
+
+	// non-zero odd tap coefficients (centre outwards).
+	static const float *coeffs();
+
+private:
+
+	synthv1_quad m_odd[M << 2];
+	synthv1_quad m_even[M - 1];
+
+	uint16_t m_iodd;
+	uint16_t m_ieven;
+};
+
+
+// Kaiser windowed sinc, 2x to 1x: 63 taps (beta = 8.96),
+// flat up to 0.204 of the input rate, under -89dB from 0.296 on.
+template <>
+inline const float *synthv1_halfband_quad<16>::coeffs (void)
+{
+	static const float s_coeffs[16] = {
+		 3.169135099e-01f, -1.019806730e-01f,  5.700122293e-02f,
+		-3.656901421e-02f,  2.459667279e-02f, -1.672379582e-02f,
+		 1.126995586e-02f, -7.427563521e-03f,  4.734938281e-03f,
+		-2.887719557e-03f,  1.663397678e-03f, -8.895580844e-04f,
+		 4.302324492e-04f, -1.796082388e-04f,  5.825705856e-05f,
+		-9.750066641e-06f
+	};
+	return s_coeffs;
+}
+
+// Kaiser windowed sinc, 4x to 2x: 23 taps (beta = 9.5),
+// flat up to 0.102 of the input rate, under -94dB from 0.398 on.
+template <>
+inline const float *synthv1_halfband_quad<6>::coeffs (void)
+{
+	static const float s_coeffs[6] = {
+		 3.066856713e-01f, -7.550431372e-02f,  2.393059608e-02f,
+		-5.927419314e-03f,  8.321758964e-04f, -1.650273856e-05f
+	};
+	return s_coeffs;
+}
+
+
 #endif	// __synthv1_filter_h
 
 
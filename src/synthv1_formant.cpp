@@ -1,7 +1,7 @@
 // synthv1_formant.cpp
 //
 /****************************************************************************
-   Copyright (C) 2012-2021, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -20,6 +20,7 @@
 *****************************************************************************/
 
 #include "synthv1_formant.h"
+#include "synthv1_fastmath.h"
 
 
 //---------------------------------------------------------------------
@@ -162,25 +163,45 @@ synthv1_formant::Vtab *synthv1_formant::g_vtabs[NUM_VTABS] = {
 };
 
 
-// compute coeffs. for given vocal formant table
+// compute coeffs. for given vocal formant table (all formants,
+// four at a time; fast approximations, see synthv1_fastmath.h)
 void synthv1_formant::Impl::vtab_coeffs (
-	Coeffs& coeffs, const Vtab *vtab, uint32_t i, float p )
+	Coeffs *coeffs, const Vtab *vtab, float p ) const
 {
-	const float Fi = vtab->freq[i];
-	const float Gi = vtab->gain[i];
-	const float Bi = vtab->band[i] * p;
-
-	const float Ai = ::powf(10.0f, (0.05f * Gi));
-	const float Ri = ::expf(-M_PI * Bi / m_srate);
-
-	coeffs.b2 = Ri * Ri;
-	coeffs.b1 = 2.0f * Ri * ::cosf(2.0f * M_PI * Fi / m_srate);
-	coeffs.a0 = Ai * (1.0f - coeffs.b1 + coeffs.b2);
+	const float w = 1.0f / m_srate;
+
+	for (uint32_t i = 0; i < NUM_FORMANTS; i += 4) {
+		// (tail lanes padded with the last formant)
+		synthv1_quad Fi, Gi, Bi;
+		for (uint32_t k = 0; k < 4; ++k) {
+			uint32_t j = i + k;
+			if (j >= NUM_FORMANTS)
+				j = NUM_FORMANTS - 1;
+			Fi[k] = vtab->freq[j];
+			Gi[k] = vtab->gain[j];
+			Bi[k] = vtab->band[j] * p;
+		}
+
+		const synthv1_quad Ai = synthv1_fast_pow10f(0.05f * Gi);
+		const synthv1_quad Ri = synthv1_fast_expf(float(-M_PI) * w * Bi);
+		const synthv1_quad b1 = 2.0f * Ri
+			* synthv1_fast_cosf(float(2.0 * M_PI) * w * Fi);
+		const synthv1_quad b2 = Ri * Ri;
+		const synthv1_quad a0 = Ai * (1.0f - b1 + b2);
+
+		for (uint32_t k = 0; k < 4 && i + k < NUM_FORMANTS; ++k) {
+			Coeffs& coeff = coeffs[i + k];
+			coeff.a0 = a0[k];
+			coeff.b1 = b1[k];
+			coeff.b2 = b2[k];
+		}
+	}
 }
 
 
 // reset method impl.
-void synthv1_formant::Impl::reset_coeffs ( float cutoff, float reso )
+void synthv1_formant::Impl::reset_coeffs (
+	float cutoff, float reso, Coeffs *ctabs ) const
 {
 	const float   fK = cutoff * float(NUM_VTABS - 1);
 	const uint32_t k = uint32_t(fK);
@@ -201,11 +222,13 @@ void synthv1_formant::Impl::reset_coeffs ( float cutoff, float reso )
 	if (k < NUM_VTABS - 1)
 		vtab2 = &g_vtabs[k + 1][0];
 
-	Coeffs coeff2;
+	Coeffs coeffs2[NUM_FORMANTS];
+	vtab_coeffs(ctabs, vtab1, p);
+	vtab_coeffs(coeffs2, vtab2, p);
+
 	for (uint32_t i = 0; i < NUM_FORMANTS; ++i) {
-		Coeffs& coeff1 = m_ctabs[i];
-		vtab_coeffs(coeff1, vtab1, i, p);
-		vtab_coeffs(coeff2, vtab2, i, p);
+		Coeffs& coeff1 = ctabs[i];
+		const Coeffs& coeff2 = coeffs2[i];
 		coeff1.a0 += dJ * (coeff2.a0 - coeff1.a0);
 		coeff1.b1 += dJ * (coeff2.b1 - coeff1.b1);
 		coeff1.b2 += dJ * (coeff2.b2 - coeff1.b2);
@@ -217,9 +240,10 @@ void synthv1_formant::Impl::reset_coeffs ( float cutoff, float reso )
 void synthv1_formant::reset_coeffs (void)
 {
 	if (m_pImpl) {
-		m_pImpl->reset_coeffs(m_cutoff, m_reso);
+		Coeffs ctabs[NUM_FORMANTS];
+		m_pImpl->reset_coeffs(m_cutoff, m_reso, ctabs);
 		for (uint32_t i = 0; i < NUM_FORMANTS; ++i)
-			m_filters[i].reset_coeffs(m_pImpl->coeffs(i));
+			m_filters[i].reset_coeffs(ctabs[i]);
 	}
 }
 
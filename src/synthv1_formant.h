@@ -1,7 +1,7 @@
 // synthv1_formant.h
 //
 /****************************************************************************
-   Copyright (C) 2012-2021, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -60,33 +60,26 @@ public:
 
 		// ctor.
 		Impl(float srate = 44100.0f)
-			: m_srate(srate) { reset_coeffs(); }
+			: m_srate(srate) {}
 
 		// sample-rate accessors
 		void setSampleRate(float srate)
-			{ m_srate = srate; reset_coeffs(); }
+			{ m_srate = srate; }
 		float sampleRate() const
 			{ return m_srate; }
 
-		// formant coeffs. accessor
-		const Coeffs& coeffs(uint32_t i) const
-			{ return m_ctabs[i]; }
-
-		// reset coeffs. method
-		void reset_coeffs(float cutoff = 0.5f, float reso = 0.0f);
+		// compute formant coeffs. (thread-safe, no shared state)
+		void reset_coeffs(float cutoff, float reso, Coeffs *ctabs) const;
 
 	protected:
 
-		// compute coeffs. for given vocal formant table
-		void vtab_coeffs(Coeffs& coeffs, const Vtab *vtab, uint32_t i, float p);
+		// compute coeffs. for given vocal formant table (all formants)
+		void vtab_coeffs(Coeffs *coeffs, const Vtab *vtab, float p) const;
 
 	private:
 
 		// instance members
 		float m_srate;
-
-		// filter coeffs.
-		Coeffs m_ctabs[NUM_FORMANTS];
 	};
 
 	// ctor.
@@ -1,7 +1,7 @@
 // synthv1_fx.h
 //
 /****************************************************************************
-   Copyright (C) 2012-2023, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -22,6 +22,8 @@
 #ifndef __synthv1_fx_h
 #define __synthv1_fx_h
 
+#include "synthv1_quad.h"
+
 #include <cstdint>
 #include <cstdlib>
 #include <cmath>
@@ -35,18 +37,125 @@
 //
 
 // Hal Chamberlain's pseudo-random linear congruential method.
-static inline float synthv1_fx_randf ()
+//
+// (one generator per effect instance, as to never share any
+//  state between channels, instances or threads)
+
+class synthv1_fx_rand
 {
-	static uint32_t s_srand = 0x9631; // magic!
-	s_srand = (s_srand * 196314165) + 907633515;
-	return s_srand / float(INT32_MAX) - 1.0f;
-}
+public:
+
+	synthv1_fx_rand() : m_srand(0x9631) {} // magic!
+
+	float randf()
+	{
+		m_srand = (m_srand * 196314165) + 907633515;
+		return m_srand / float(INT32_MAX) - 1.0f;
+	}
+
+private:
+
+	uint32_t m_srand;
+};
+
+
+//-------------------------------------------------------------------------
+// synthv1_fx_tail - tail-aware automatic bypass.
+//
+// an effect goes dormant once both its input and its own (dry) output
+// have stayed below the silence threshold for as long as its longest
+// tail (delay line or feedback network); its state is then cleared, so
+// it may be skipped altogether while input remains silent. any input
+// above threshold wakes it up again.
+
+class synthv1_fx_tail
+{
+public:
+
+	synthv1_fx_tail() { reset(); }
+
+	void reset()
+	{
+		m_peak = 0.0f;
+		m_nsilent = 0;
+		m_dormant = false;
+	}
+
+	bool isDormant() const
+		{ return m_dormant; }
+
+	// whether processing is to be skipped (dormant, input still silent).
+	bool bypass(const float *in, uint32_t nframes)
+	{
+		m_peak = peak(in, nframes);
+		return bypass();
+	}
+
+	bool bypass(const float *in0, const float *in1, uint32_t nframes)
+	{
+		m_peak = peak(in0, nframes);
+		const float peak1 = peak(in1, nframes);
+		if (m_peak < peak1)
+			m_peak = peak1;
+		return bypass();
+	}
+
+	// account for the effect output peak, after processing; true when
+	// the tail has just decayed (effect state should be cleared).
+	bool update(float peak, uint32_t nframes, uint32_t ntail)
+	{
+		if (peak < m_peak)
+			peak = m_peak;
+		if (peak < THRESHOLD) {
+			m_nsilent += nframes;
+			m_dormant = (m_nsilent >= ntail);
+		} else {
+			m_nsilent = 0;
+		}
+		return m_dormant;
+	}
+
+	static float peak(const float *in, uint32_t nframes)
+	{
+		float ret = 0.0f;
+		for (uint32_t i = 0; i < nframes; ++i) {
+			const float a = ::fabsf(in[i]);
+			if (ret < a)
+				ret = a;
+		}
+		return ret;
+	}
+
+	// silence threshold (-120dB).
+	static constexpr float THRESHOLD = 1E-6f;
+
+protected:
+
+	bool bypass()
+	{
+		if (m_dormant) {
+			if (m_peak < THRESHOLD)
+				return true;
+			m_dormant = false;
+			m_nsilent = 0;
+		}
+		return false;
+	}
+
+private:
+
+	float    m_peak;
+	uint32_t m_nsilent;
+	bool     m_dormant;
+};
 
 
 //-------------------------------------------------------------------------
 // synthv1_fx_filter - RBJ biquad filter implementation.
 //
 //   http://www.musicdsp.org/files/Audio-EQ-Cookbook.txt
+//
+// (up to four channels at once, one per SIMD lane)
 
 class synthv1_fx_filter
 {
@@ -187,10 +296,10 @@ public:
 		m_a2a0 = a2 / a0;
 	};
 
-	float output(float in)
+	synthv1_quad output(const synthv1_quad& in)
 	{
 		// filter
-		const float out = m_b0a0 * in
+		const synthv1_quad out = m_b0a0 * in
 			+ m_b1a0 * m_in1  + m_b2a0 * m_in2
 			- m_a1a0 * m_out1 - m_a2a0 * m_out2;
 		// push in/out buffers
@@ -207,8 +316,8 @@ protected:
 	void reset()
 	{
 		m_b0a0 = m_b1a0 = m_b2a0 = m_a1a0 = m_a2a0 = 0.0f;
-		m_out1 = m_out2 = 0.0f;
-		m_in1 = m_in2 = 0.0f;
+		m_out1 = m_out2 = synthv1_quad_dup(0.0f);
+		m_in1 = m_in2 = synthv1_quad_dup(0.0f);
 	}
 
 private:
@@ -219,20 +328,29 @@ private:
 	// filter coeffs
 	float m_b0a0, m_b1a0, m_b2a0, m_a1a0, m_a2a0;
 
-	// in/out history
-	float m_out1, m_out2, m_in1, m_in2;
+	// in/out history (per lane)
+	synthv1_quad m_out1, m_out2, m_in1, m_in2;
 };
 
 
 //-------------------------------------------------------------------------
 // synthv1_fx_comp - DiscoDSP's "rock da disco" compressor/eq.
+//
+// (up to four channels at once, one per SIMD lane; the gain envelope
+//  follows the mean gain of each control period, then ramped linearly)
 
 class synthv1_fx_comp
 {
 public:
 
+	// maximum number of channels (SIMD lanes).
+	static const uint16_t MAX_CHANNELS = 4;
+
+	// control period (envelope detection), in frames.
+	static const uint32_t CTL_FRAMES = 16;
+
 	synthv1_fx_comp(float srate = 44100.0f)
-		: m_srate(srate), m_peak(0.0f),
+		: m_srate(srate), m_peak(synthv1_quad_dup(0.0f)),
 			m_attack(0.0f), m_release(0.0f),
 			m_lo(srate), m_mi(srate), m_hi(srate) {}
 
@@ -250,8 +368,9 @@ public:
 
 	void reset()
 	{
-		m_peak = 0.0f;
+		m_peak = synthv1_quad_dup(0.0f);
 
+		// envelope coeffs, per frame...
 		m_attack  = ::expf(-1000.0f / (m_srate * 3.6f));
 		m_release = ::expf(-1000.0f / (m_srate * 150.0f));
 
@@ -261,33 +380,63 @@ public:
 		m_hi.reset(synthv1_fx_filter::HiShelf, 10000.0f, 1.0f, 4.0f);
 	}
 
-	void process(float *in, uint32_t nframes)
+	void process(float **ins, uint16_t nchannels, uint32_t nframes)
 	{
+		if (nchannels > MAX_CHANNELS)
+			nchannels = MAX_CHANNELS;
 		// compressor
 		const float threshold = 0.251f;	//~= powf(10.0f, -12.0f / 20.0f);
 		const float post_gain = 1.995f;	//~= powf(10.0f, 6.0f / 20.0f);
-		// process buffers
-		for (uint32_t i = 0; i < nframes; ++i) {
+		const synthv1_quad thresh = synthv1_quad_dup(threshold);
+		const synthv1_quadi abs_mask = synthv1_quadi{
+			INT32_MAX, INT32_MAX, INT32_MAX, INT32_MAX };
+		// envelope coeffs, per (full) control period
+		const float attack_ctl  = ::powf(m_attack,  float(CTL_FRAMES));
+		const float release_ctl = ::powf(m_release, float(CTL_FRAMES));
+		// process buffers, one control period at a time
+		synthv1_quad lo[CTL_FRAMES];
+		uint32_t offset = 0;
+		while (offset < nframes) {
+			uint32_t nctl = nframes - offset;
+			if (nctl > CTL_FRAMES)
+				nctl = CTL_FRAMES;
 			// anti-denormalizer noise
-			const float ad = 1E-14f * synthv1_fx_randf();
-			// process
-			const float lo = m_lo.output(m_mi.output(m_hi.output(*in + ad)));
-			// compute peak
-			const float peak = ::fabsf(lo);
-			// compute gain
-			float gain = 1.0f;
-			if (peak > threshold)
-				gain = threshold / peak;
+			const synthv1_quad ad = 1E-14f * synthv1_quad_set(
+				m_rand.randf(), m_rand.randf(), m_rand.randf(), m_rand.randf());
+			// eq. and gain detection
+			synthv1_quad gsum = synthv1_quad_dup(0.0f);
+			for (uint32_t i = 0; i < nctl; ++i) {
+				synthv1_quad in = ad;
+				for (uint16_t k = 0; k < nchannels; ++k)
+					in[k] += ins[k][offset + i];
+				lo[i] = m_lo.output(m_mi.output(m_hi.output(in)));
+				const synthv1_quad a = synthv1_quad_from_bits(
+					synthv1_quad_bits(lo[i]) & abs_mask);
+				// compute gain (= min(1, threshold / |lo|))
+				gsum += thresh / synthv1_quad_select(a > thresh, a, thresh);
+			}
+			const synthv1_quad gain = gsum * (1.0f / float(nctl));
 			// envelope
-			if (m_peak > gain) {
-				m_peak *= m_attack;
-				m_peak += (1.0f - m_attack) * gain;
-			} else {
-				m_peak *= m_release;
-				m_peak += (1.0f - m_release) * gain;
+			float attack = attack_ctl;
+			float release = release_ctl;
+			if (nctl < CTL_FRAMES) {
+				attack  = ::powf(m_attack,  float(nctl));
+				release = ::powf(m_release, float(nctl));
 			}
-			// output
-			*in++ = lo * m_peak * post_gain;
+			const synthv1_quad coeff = synthv1_quad_select(m_peak > gain,
+				synthv1_quad_dup(attack), synthv1_quad_dup(release));
+			const synthv1_quad peak1 = gain + (m_peak - gain) * coeff;
+			// output, gain ramped along the control period
+			const synthv1_quad dg = (peak1 - m_peak) * (post_gain / float(nctl));
+			synthv1_quad g = m_peak * post_gain;
+			for (uint32_t i = 0; i < nctl; ++i) {
+				g += dg;
+				const synthv1_quad out = lo[i] * g;
+				for (uint16_t k = 0; k < nchannels; ++k)
+					ins[k][offset + i] = out[k];
+			}
+			m_peak = peak1;
+			offset += nctl;
 		}
 	}
 
@@ -295,11 +444,14 @@ private:
 
 	float m_srate;
 
-	float m_peak;
+	synthv1_quad m_peak;
+
 	float m_attack;
 	float m_release;
 
 	synthv1_fx_filter m_lo, m_mi, m_hi;
+
+	synthv1_fx_rand m_rand;
 };
 
 
@@ -315,6 +467,13 @@ public:
 		{ reset(); }
 
 	void reset()
+	{
+		clear();
+
+		m_tail.reset();
+	}
+
+	void clear()
 	{
 		for(uint32_t i = 0; i < MAX_SIZE; ++i)
 			m_buffer[i] = 0.0f;
@@ -322,6 +481,9 @@ public:
 		m_frames = 0;
 	}
 
+	bool isDormant() const
+		{ return m_tail.isDormant(); }
+
 	float output(float in, float delay, float feedb)
 	{
 		// calculate delay offset
@@ -362,9 +524,21 @@ public:
 		//	feedb *= (1.0f - daft);
 		}
 		delay *= float(MAX_SIZE);
+		// dormant?
+		if (m_tail.bypass(in, nframes))
+			return;
 		// process
-		for (uint32_t i = 0; i < nframes; ++i)
-			in[i] += wet * output(in[i], delay, feedb);
+		float peak = 0.0f;
+		for (uint32_t i = 0; i < nframes; ++i) {
+			const float out = output(in[i], delay, feedb);
+			in[i] += wet * out;
+			const float a = ::fabsf(out);
+			if (peak < a)
+				peak = a;
+		}
+		// tail decayed?
+		if (m_tail.update(peak, nframes, MAX_SIZE))
+			clear();
 	}
 
 	static const uint32_t MAX_SIZE = (1 << 12);	//= 4096;
@@ -375,6 +549,8 @@ private:
 	float m_buffer[MAX_SIZE];
 
 	uint32_t m_frames;
+
+	synthv1_fx_tail m_tail;
 };
 
 
@@ -399,8 +575,13 @@ public:
 		m_flang2.reset();
 
 		m_lfo = 0.0f;
+
+		m_tail.reset();
 	}
 
+	bool isDormant() const
+		{ return m_tail.isDormant(); }
+
 	void process(float *in1, float *in2, uint32_t nframes,
 		float wet, float delay, float feedb, float rate, float mod)
 	{
@@ -412,20 +593,42 @@ public:
 		const float d0 = 0.5f * delay * float(synthv1_fx_flanger::MAX_SIZE);
 		const float a1 = 0.99f * d0 * mod * mod;
 		const float r2 = 4.0f * M_PI * rate * rate / m_srate;
+		// dormant? (lfo keeps running)
+		if (m_tail.bypass(in1, in2, nframes)) {
+			m_lfo += r2 * float(nframes);
+			while (m_lfo >= 1.0f)
+				m_lfo -= 2.0f;
+			return;
+		}
 		// process
+		float peak = 0.0f;
 		for (uint32_t i = 0; i < nframes; ++i) {
 			// modulation
 			const float lfo = a1 * pseudo_sinf(m_lfo);
 			const float delay1 = d0 - lfo;
 			const float delay2 = d0 - lfo * 0.9f;
 			// chorus mix
-			in1[i] += wet * m_flang1.output(in1[i], delay1, feedb);
-			in2[i] += wet * m_flang2.output(in2[i], delay2, feedb);
+			const float out1 = m_flang1.output(in1[i], delay1, feedb);
+			const float out2 = m_flang2.output(in2[i], delay2, feedb);
+			in1[i] += wet * out1;
+			in2[i] += wet * out2;
 			// lfo advance
 			m_lfo += r2;
 			// lfo wrap
 			if (m_lfo >= 1.0f)
 				m_lfo -= 2.0f;
+			// peak
+			const float p1 = ::fabsf(out1);
+			const float p2 = ::fabsf(out2);
+			if (peak < p1)
+				peak = p1;
+			if (peak < p2)
+				peak = p2;
+		}
+		// tail decayed?
+		if (m_tail.update(peak, nframes, synthv1_fx_flanger::MAX_SIZE)) {
+			m_flang1.clear();
+			m_flang2.clear();
 		}
 	}
 
@@ -446,6 +649,8 @@ private:
 	synthv1_fx_flanger m_flang2;
 
 	float m_lfo;
+
+	synthv1_fx_tail m_tail;
 };
 
 
@@ -465,6 +670,13 @@ public:
 		{ return m_srate; }
 
 	void reset()
+	{
+		clear();
+
+		m_tail.reset();
+	}
+
+	void clear()
 	{
 		for (uint32_t i = 0; i < MAX_SIZE; ++i)
 			m_buffer[i] = 0.0f;
@@ -473,6 +685,9 @@ public:
 		m_frames = 0;
 	}
 
+	bool isDormant() const
+		{ return m_tail.isDormant(); }
+
 	void process(float *in, uint32_t nframes,
 		float wet, float delay, float feedb, float bpm = 0.0f)
 	{
@@ -492,13 +707,23 @@ public:
 		else
 		if (ndelay > MAX_SIZE)
 			ndelay = MAX_SIZE;
+		// dormant?
+		if (m_tail.bypass(in, nframes))
+			return;
 		// delay process
+		float peak = 0.0f;
 		for (uint32_t i = 0; i < nframes; ++i) {
 			const uint32_t j = (m_frames++) & MAX_MASK;
 			m_out = m_buffer[(j - ndelay) & MAX_MASK];
 			m_buffer[j] = *in + m_out * feedb;
 			*in++ += wet * m_out;
+			const float a = ::fabsf(m_out);
+			if (peak < a)
+				peak = a;
 		}
+		// tail decayed? (over the current delay time)
+		if (m_tail.update(peak, nframes, ndelay))
+			clear();
 	}
 
 	static const uint32_t MIN_SIZE = (1 <<  8);	//= 256;
@@ -513,6 +738,8 @@ private:
 	float m_out;
 
 	uint32_t m_frames;
+
+	synthv1_fx_tail m_tail;
 };
 
 
@@ -560,14 +787,25 @@ public:
 
 	void reset()
 	{
-		// initialize vars
+		clear();
+
 		m_lfo_phase = 0.0f;
+
+		m_tail.reset();
+	}
+
+	void clear()
+	{
+		// initialize vars
 		m_out = 0.0f;
 		// reset taps
 		for (uint16_t n = 0; n < MAX_TAPS; ++n)
 			m_taps[n].reset();
 	}
 
+	bool isDormant() const
+		{ return m_tail.isDormant(); }
+
 	void process(float *in, uint32_t nframes, float wet,
 		float rate, float feedb, float depth, float daft)
 	{
@@ -584,9 +822,17 @@ public:
 		const float delay_min = 2.0f * 440.0f / m_srate;
 		const float delay_max = 2.0f * 4400.0f / m_srate;
 		const float lfo_inc   = 2.0f * M_PI * rate / m_srate;
+		// dormant? (lfo keeps running)
+		if (m_tail.bypass(in, nframes)) {
+			m_lfo_phase += lfo_inc * float(nframes);
+			while (m_lfo_phase >= 2.0f * M_PI)
+				m_lfo_phase -= 2.0f * M_PI;
+			return;
+		}
 		// anti-denormal noise
-		const float adenormal = 1E-14f * synthv1_fx_randf();
+		const float adenormal = 1E-14f * m_rand.randf();
 		// sweep...
+		float peak = 0.0f;
 		for (uint32_t i = 0; i < nframes; ++i) {
 			// calculate and update phaser lfo
 			const float delay = delay_min + (delay_max - delay_min)
@@ -603,7 +849,14 @@ public:
 				m_out = m_taps[n].output(m_out, delay);
 			// output
 			in[i] += wet * m_out * depth;
+			// peak
+			const float a = ::fabsf(m_out);
+			if (peak < a)
+				peak = a;
 		}
+		// tail decayed? (all-pass taps and feedback, ~100ms)
+		if (m_tail.update(peak, nframes, uint32_t(0.1f * m_srate)))
+			clear();
 	}
 
 private:
@@ -622,6 +875,10 @@ private:
 	float m_depth;
 
 	float m_out;
+
+	synthv1_fx_rand m_rand;
+
+	synthv1_fx_tail m_tail;
 };
 
 
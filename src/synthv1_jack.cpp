@@ -117,12 +117,37 @@ int synthv1_jack_process ( jack_nframes_t nframes, void *arg )
 
 static int synthv1_jack_buffer_size ( jack_nframes_t nframes, void *arg )
 {
-	static_cast<synthv1_jack *> (arg)->setBufferSize(nframes);
+	static_cast<synthv1_jack *> (arg)->bufferSizeChanged(nframes);
 
 	return 0;
 }
 
 
+#ifdef CONFIG_JACK_LATENCY
+
+//----------------------------------------------------------------------
+// JACK latency callback.
+
+static void synthv1_jack_latency (
+	jack_latency_callback_mode_t mode, void *arg )
+{
+	static_cast<synthv1_jack *> (arg)->updateLatency(mode);
+}
+
+#endif	// CONFIG_JACK_LATENCY
+
+
+#ifdef CONFIG_JACK_METADATA
+
+//----------------------------------------------------------------------
+// JACK client idle state property (key and value type).
+
+#define SYNTHV1_JACK_IDLE_KEY  "http://synthv1.sourceforge.net/lv2#idle"
+#define SYNTHV1_JACK_IDLE_TYPE "http://www.w3.org/2001/XMLSchema#boolean"
+
+#endif	// CONFIG_JACK_METADATA
+
+
 //----------------------------------------------------------------------
 // JACK on-shutdown callback.
 
@@ -158,7 +183,8 @@ static void synthv1_jack_session_event (
 // synthv1_jack - impl.
 //
 
-synthv1_jack::synthv1_jack (const char *client_name) : synthv1(2)
+synthv1_jack::synthv1_jack ( const char *client_name, uint16_t nvoices )
+	: synthv1(2, 44100.0f, 1024, nvoices)
 {
 	m_client = nullptr;
 
@@ -174,6 +200,10 @@ synthv1_jack::synthv1_jack (const char *client_name) : synthv1(2)
 #ifdef CONFIG_JACK_MIDI
 	m_midi_in = nullptr;
 #endif
+#ifdef CONFIG_JACK_METADATA
+	m_uuid = 0;
+	m_idle = -1;
+#endif
 #ifdef CONFIG_ALSA_MIDI
 	m_alsa_seq     = nullptr;
 //	m_alsa_client  = -1;
@@ -204,6 +234,75 @@ jack_client_t *synthv1_jack::client (void) const
 }
 
 
+// JACK buffer-size change handler.
+void synthv1_jack::bufferSizeChanged ( jack_nframes_t nframes )
+{
+	synthv1::setBufferSize(nframes);
+
+	// pipelined effects chain follows the period...
+	if (synthv1::fxPipeline() > 0) {
+		synthv1::setFxPipeline(nframes);
+	#ifdef CONFIG_JACK_LATENCY
+		// ...and so does our own latency.
+		::jack_recompute_total_latencies(m_client);
+	#endif
+	}
+}
+
+
+#ifdef CONFIG_JACK_LATENCY
+
+// JACK latency handler: port ranges plus our own (pipelined effects).
+void synthv1_jack::updateLatency ( jack_latency_callback_mode_t mode )
+{
+	const uint16_t nchannels = synthv1::channels();
+	const jack_nframes_t nlatency = synthv1::latency();
+
+	jack_latency_range_t range;
+
+	for (uint16_t k = 0; k < nchannels; ++k) {
+		if (mode == JackCaptureLatency) {
+			::jack_port_get_latency_range(m_audio_ins[k], mode, &range);
+			range.min += nlatency;
+			range.max += nlatency;
+			::jack_port_set_latency_range(m_audio_outs[k], mode, &range);
+		} else {
+			::jack_port_get_latency_range(m_audio_outs[k], mode, &range);
+			range.min += nlatency;
+			range.max += nlatency;
+			::jack_port_set_latency_range(m_audio_ins[k], mode, &range);
+		#ifdef CONFIG_JACK_MIDI
+			if (k == 0 && m_midi_in)
+				::jack_port_set_latency_range(m_midi_in, mode, &range);
+		#endif
+		}
+	}
+}
+
+#endif	// CONFIG_JACK_LATENCY
+
+
+#ifdef CONFIG_JACK_METADATA
+
+// JACK client idle state property, published on change only
+// (no voices playing and effects tails decayed; "true"/"false").
+void synthv1_jack::updateIdle (void)
+{
+	if (m_client == nullptr || !m_activated)
+		return;
+
+	const int idle = (synthv1::isIdle() ? 1 : 0);
+	if (m_idle == idle)
+		return;
+
+	if (::jack_set_property(m_client, m_uuid, SYNTHV1_JACK_IDLE_KEY,
+			(idle ? "true" : "false"), SYNTHV1_JACK_IDLE_TYPE) == 0)
+		m_idle = idle;
+}
+
+#endif	// CONFIG_JACK_METADATA
+
+
 int synthv1_jack::process ( jack_nframes_t nframes )
 {
 	if (!m_activated)
@@ -309,6 +408,16 @@ void synthv1_jack::open ( const char *client_name )
 	if (m_client == nullptr)
 		return;
 
+#ifdef CONFIG_JACK_METADATA
+	// client uuid, subject of the idle state property...
+	char *pszUuid = ::jack_client_get_uuid(m_client);
+	if (pszUuid) {
+		::jack_uuid_parse(pszUuid, &m_uuid);
+		::jack_free(pszUuid);
+	}
+	m_idle = -1;
+#endif
+
 	// set sample rate
 	synthv1::setSampleRate(float(jack_get_sample_rate(m_client)));
 //	synthv1::reset();
@@ -364,9 +473,19 @@ void synthv1_jack::open ( const char *client_name )
 	// setup any local, initial buffers...
 	synthv1::setBufferSize(::jack_get_buffer_size(m_client) << 2);
 
+	// pipelined effects chain, if any, one JACK period behind...
+	if (synthv1::fxPipeline() > 0)
+		synthv1::setFxPipeline(::jack_get_buffer_size(m_client));
+
 	::jack_set_buffer_size_callback(m_client,
 		synthv1_jack_buffer_size, this);
 
+#ifdef CONFIG_JACK_LATENCY
+	// report our own latency (pipelined effects)...
+	::jack_set_latency_callback(m_client,
+		synthv1_jack_latency, this);
+#endif
+
 	::jack_on_shutdown(m_client,
 		synthv1_jack_on_shutdown, this);
 
@@ -484,6 +603,14 @@ void synthv1_jack::close (void)
 		m_audio_ins = nullptr;
 	}
 
+#ifdef CONFIG_JACK_METADATA
+	// withdraw the idle state property
+	if (m_idle >= 0) {
+		::jack_remove_property(m_client, m_uuid, SYNTHV1_JACK_IDLE_KEY);
+		m_idle = -1;
+	}
+#endif
+
 	// close client
 	::jack_client_close(m_client);
 	m_client = nullptr;
@@ -727,7 +854,8 @@ static void synthv1_sigterm_handler ( int /*signo*/ )
 // Constructor.
 synthv1_jack_application::synthv1_jack_application ( int& argc, char **argv )
 	: QObject(nullptr), m_pApp(nullptr), m_bGui(true),
-		m_sClientName(PROJECT_NAME), m_pSynth(nullptr), m_pWidget(nullptr)
+		m_sClientName(PROJECT_NAME), m_iPolyphony(0),
+		m_pSynth(nullptr), m_pWidget(nullptr)
 	  #ifdef CONFIG_NSM
 		, m_pNsmClient(nullptr)
 	  #endif
@@ -850,6 +978,7 @@ bool synthv1_jack_application::parse_args (void)
 
 	const QString s_no_gui      = "no-gui";
 	const QString s_client_name = "client-name";
+	const QString s_polyphony   = "polyphony";
 	const QString s_help        = "help";
 
 	parser.addOption({{"g", s_no_gui},
@@ -857,6 +986,9 @@ bool synthv1_jack_application::parse_args (void)
 	parser.addOption({{"n", s_client_name},
 		QObject::tr("Set the JACK client name (default: %1)")
 			.arg(PROJECT_NAME), "label"});
+	parser.addOption({{"p", s_polyphony},
+		QObject::tr("Set the number of voices (default: %1)")
+			.arg(synthv1_config::defaultPolyphony()), "num"});
 	parser.addOption({{"?", s_help},
 		QObject::tr("Displays help on command-line options.")});
 	const QCommandLineOption& versionOption = parser.addVersionOption();
@@ -906,6 +1038,16 @@ bool synthv1_jack_application::parse_args (void)
 		m_sClientName = sVal;
 	}
 
+	if (parser.isSet(s_polyphony)) {
+		bool bOk = false;
+		const int iVal = parser.value(s_polyphony).toInt(&bOk);
+		if (!bOk || iVal < 1 || iVal > 256) {
+			show_error(QObject::tr("Option -p requires an argument (num)."));
+			return false;
+		}
+		m_iPolyphony = uint16_t(iVal);
+	}
+
 	foreach (const QString& sArg, parser.positionalArguments()) {
 		m_presets.append(sArg);
 	}
@@ -941,6 +1083,17 @@ bool synthv1_jack_application::parse_args (void)
 				++i;
 		}
 		else
+		if (sArg == "-p" || sArg == "--polyphony") {
+			const int iVal = sVal.toInt();
+			if (sVal.isNull() || iVal < 1 || iVal > 256) {
+				out << QObject::tr("Option -p requires an argument (num).\n\n");
+				return false;
+			}
+			m_iPolyphony = uint16_t(iVal);
+			if (iEqual < 0)
+				++i;
+		}
+		else
 		if (sArg == "-?" || sArg == "--help") {
 			const QString sEot = "\n\t";
 			const QString sEol = "\n\n";
@@ -951,6 +1104,9 @@ bool synthv1_jack_application::parse_args (void)
 				QObject::tr("Disable the graphical user interface (GUI)") + sEol;
 			out << "  -n, --client-name <label>" + sEot +
 				QObject::tr("Set the JACK client name (default: %1)").arg(PROJECT_NAME) + sEol;
+			out << "  -p, --polyphony <num>" + sEot +
+				QObject::tr("Set the number of voices (default: %1)")
+					.arg(synthv1_config::defaultPolyphony()) + sEol;
 			out << "  -?, --help" + sEot +
 				QObject::tr("Show help about command line options.") + sEol;
 			out << "  -v, --version" + sEot +
@@ -1002,7 +1158,7 @@ bool synthv1_jack_application::setup (void)
 	const char *client_name
 		= aClientName.constData();
 
-	m_pSynth = new synthv1_jack(client_name);
+	m_pSynth = new synthv1_jack(client_name, m_iPolyphony);
 
 	if (m_bGui)
 		m_pWidget = new synthv1widget_jack(m_pSynth);
@@ -1053,6 +1209,11 @@ bool synthv1_jack_application::setup (void)
 	// Start watchdog timer...
 	watchdog_start();
 
+#ifdef CONFIG_JACK_METADATA
+	// Start idle state timer...
+	idle_start();
+#endif
+
 	return true;
 }
 
@@ -1238,6 +1399,27 @@ void synthv1_jack_application::watchdog_start (void)
 }
 
 
+#ifdef CONFIG_JACK_METADATA
+
+// Idle state property update (half a second cycle).
+void synthv1_jack_application::idle_slot (void)
+{
+	if (m_pSynth)
+		m_pSynth->updateIdle();
+
+	idle_start();
+}
+
+
+void synthv1_jack_application::idle_start (void)
+{
+	if (g_pInstance)
+		QTimer::singleShot(500, this, SLOT(idle_slot()));
+}
+
+#endif	// CONFIG_JACK_METADATA
+
+
 // JACK shutdown handlers.
 void synthv1_jack_application::shutdown (void)
 {
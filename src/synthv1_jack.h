@@ -26,6 +26,9 @@
 
 #include <jack/jack.h>
 
+#ifdef CONFIG_JACK_METADATA
+#include <jack/metadata.h>
+#endif
 
 #ifdef CONFIG_ALSA_MIDI
 #include <jack/ringbuffer.h>
@@ -43,7 +46,7 @@ class synthv1_jack : public synthv1
 {
 public:
 
-	synthv1_jack(const char *client_name);
+	synthv1_jack(const char *client_name, uint16_t nvoices = 0);
 
 	~synthv1_jack();
 
@@ -57,6 +60,19 @@ public:
 
 	int process(jack_nframes_t nframes);
 
+	// JACK buffer-size change handler.
+	void bufferSizeChanged(jack_nframes_t nframes);
+
+#ifdef CONFIG_JACK_LATENCY
+	// JACK latency handler (pipelined effects).
+	void updateLatency(jack_latency_callback_mode_t mode);
+#endif
+
+#ifdef CONFIG_JACK_METADATA
+	// JACK client idle state property (off the audio thread).
+	void updateIdle();
+#endif
+
 #ifdef CONFIG_ALSA_MIDI
 	snd_seq_t *alsa_seq() const;
 	void alsa_capture(snd_seq_event_t *ev);
@@ -94,6 +110,10 @@ private:
 #ifdef CONFIG_JACK_MIDI
 	jack_port_t *m_midi_in;
 #endif
+#ifdef CONFIG_JACK_METADATA
+	jack_uuid_t m_uuid;
+	int m_idle;
+#endif
 #ifdef CONFIG_ALSA_MIDI
 	snd_seq_t *m_alsa_seq;
 //	int m_alsa_client;
@@ -168,6 +188,10 @@ protected slots:
 	void watchdog_slot();
 	void shutdown_slot();
 
+#ifdef CONFIG_JACK_METADATA
+	void idle_slot();
+#endif
+
 protected:
 
 	// Argument parser method.
@@ -181,6 +205,10 @@ protected:
 
 	void watchdog_start();
 
+#ifdef CONFIG_JACK_METADATA
+	void idle_start();
+#endif
+
 private:
 
 	// Instance variables.
@@ -190,6 +218,8 @@ private:
 	QString m_sClientName;
 	QStringList m_presets;
 
+	uint16_t m_iPolyphony;
+
 	synthv1_jack *m_pSynth;
 	synthv1widget_jack *m_pWidget;
 
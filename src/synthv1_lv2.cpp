@@ -1,7 +1,7 @@
 // synthv1_lv2.cpp
 //
 /****************************************************************************
-   Copyright (C) 2012-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -91,15 +91,54 @@ typedef struct {
 } synthv1_lv2_worker_message;
 
 
+// polyphony option, if given by host (0 = default).
+static uint16_t synthv1_lv2_polyphony ( const LV2_Feature *const *host_features )
+{
+	LV2_URID_Map *urid_map = nullptr;
+	const LV2_Options_Option *host_options = nullptr;
+
+	for (int i = 0; host_features && host_features[i]; ++i) {
+		const LV2_Feature *host_feature = host_features[i];
+		if (::strcmp(host_feature->URI, LV2_URID_MAP_URI) == 0)
+			urid_map = (LV2_URID_Map *) host_feature->data;
+		else
+		if (::strcmp(host_feature->URI, LV2_OPTIONS__options) == 0)
+			host_options = (const LV2_Options_Option *) host_feature->data;
+	}
+
+	if (urid_map == nullptr || host_options == nullptr)
+		return 0;
+
+	const LV2_URID polyphony = urid_map->map(
+		urid_map->handle, SYNTHV1_LV2_PREFIX "POLYPHONY");
+	const LV2_URID atom_Int = urid_map->map(
+		urid_map->handle, LV2_ATOM__Int);
+
+	for (int i = 0; host_options[i].key; ++i) {
+		const LV2_Options_Option *host_option = &host_options[i];
+		if (host_option->key == polyphony && host_option->type == atom_Int) {
+			// out of range? engine default instead (not truncated)...
+			const int32_t nvoices = *(int32_t *) host_option->value;
+			if (nvoices > 0 && nvoices <= 256)
+				return uint16_t(nvoices);
+		}
+	}
+
+	return 0;
+}
+
+
 synthv1_lv2::synthv1_lv2 (
 	double sample_rate, const LV2_Feature *const *host_features )
-	: synthv1(2, float(sample_rate))
+	: synthv1(2, float(sample_rate), 1024, synthv1_lv2_polyphony(host_features))
 {
 	::memset(&m_urids, 0, sizeof(m_urids));
 
 	m_urid_map = nullptr;
 	m_atom_in  = nullptr;
 	m_atom_out = nullptr;
+	m_latency  = nullptr;
+	m_idle     = nullptr;
 	m_schedule = nullptr;
 	m_ndelta   = 0;
 
@@ -186,6 +225,7 @@ synthv1_lv2::synthv1_lv2 (
 	}
 
 	uint32_t buffer_size = 1024; // maybe some safe default?
+	uint32_t nominal_size = 0;
 
 	for (int i = 0; host_options && host_options[i].key; ++i) {
 		const LV2_Options_Option *host_option = &host_options[i];
@@ -199,7 +239,7 @@ synthv1_lv2::synthv1_lv2 (
 		#ifdef LV2_BUF_SIZE__nominalBlockLength
 			else
 			if (host_option->key == m_urids.bufsz_nominalBlockLength)
-				block_length = *(int32_t *) host_option->value;
+				nominal_size = block_length = *(int32_t *) host_option->value;
 		#endif
 			// choose the lengthier...
 			if (buffer_size < block_length)
@@ -209,6 +249,10 @@ synthv1_lv2::synthv1_lv2 (
 
 	synthv1::setBufferSize(buffer_size);
 
+	// pipelined effects chain, if any, one nominal block behind...
+	if (synthv1::fxPipeline() > 0)
+		synthv1::setFxPipeline(nominal_size > 0 ? nominal_size : buffer_size);
+
 	lv2_atom_forge_init(&m_forge, m_urid_map);
 
 	const uint16_t nchannels = synthv1::channels();
@@ -247,6 +291,12 @@ void synthv1_lv2::connect_port ( uint32_t port, void *data )
 	case AudioOutR:
 		m_outs[1] = (float *) data;
 		break;
+	case Latency:
+		m_latency = (float *) data;
+		break;
+	case Idle:
+		m_idle = (float *) data;
+		break;
 	default:
 		synthv1::setParamPort(synthv1::ParamIndex(port - ParamBase), (float *) data);
 		break;
@@ -379,6 +429,14 @@ void synthv1_lv2::run ( uint32_t nframes )
 
 	if (nframes > ndelta)
 		synthv1::process(ins, outs, nframes - ndelta);
+
+	// report latency (pipelined effects)...
+	if (m_latency)
+		*m_latency = float(synthv1::latency());
+
+	// report idle state (no voices, effects tails decayed)...
+	if (m_idle)
+		*m_idle = (synthv1::isIdle() ? 1.0f : 0.0f);
 }
 
 
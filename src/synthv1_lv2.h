@@ -1,7 +1,7 @@
 // synthv1_lv2.h
 //
 /****************************************************************************
-   Copyright (C) 2012-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -74,7 +74,9 @@ public:
 		AudioInR,
 		AudioOutL,
 		AudioOutR,
-		ParamBase
+		ParamBase,
+		Latency = ParamBase + synthv1::NUM_PARAMS,
+		Idle
 	};
 
 	void connect_port(uint32_t port, void *data);
@@ -170,6 +172,9 @@ private:
 	LV2_Atom_Sequence *m_atom_in;
 	LV2_Atom_Sequence *m_atom_out;
 
+	float *m_latency;
+	float *m_idle;
+
 	float **m_ins;
 	float **m_outs;
 
@@ -199,7 +199,10 @@ struct ParamInfo {
 	{ "DYN1_LIMITER",  PARAM_BOOL,    1.0f,   0.0f,   1.0f }, // Dynamic Limiter
 
 	{ "KEY1_LOW",      PARAM_INT,     0.0f,   0.0f, 127.0f }, // Keyboard Low
-	{ "KEY1_HIGH",     PARAM_INT,   127.0f,   0.0f, 127.0f }  // Keyboard High
+	{ "KEY1_HIGH",     PARAM_INT,   127.0f,   0.0f, 127.0f }, // Keyboard High
+
+	{ "DCO1_POLYBLEP", PARAM_BOOL,    0.0f,   0.0f,   1.0f }, // DCO1 PolyBLEP
+	{ "DCO2_POLYBLEP", PARAM_BOOL,    0.0f,   0.0f,   1.0f }  // DCO2 PolyBLEP
 };
 
 
@@ -0,0 +1,268 @@
+// synthv1_pool.cpp
+//
+/****************************************************************************
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "synthv1_pool.h"
+
+#include <QThread>
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
+#define SYNTHV1_POOL_SCHED 0
+#else
+#define SYNTHV1_POOL_SCHED 1
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+//-------------------------------------------------------------------------
+// synthv1_pool_sched - real-time scheduling helpers.
+//
+
+// current thread scheduling, encoded as policy (high 16 bit) and
+// priority (low 16 bit); zero if not real-time (SCHED_FIFO/RR).
+static int synthv1_pool_sched_self (void)
+{
+#if SYNTHV1_POOL_SCHED
+	int policy = SCHED_OTHER;
+	struct sched_param param;
+	if (::pthread_getschedparam(::pthread_self(), &policy, &param) == 0
+		&& (policy == SCHED_FIFO || policy == SCHED_RR))
+		return (policy << 16) | (param.sched_priority & 0xffff);
+#endif
+	return 0;
+}
+
+
+// set current thread scheduling, as above; false if denied.
+static bool synthv1_pool_sched_set ( int sched )
+{
+#if SYNTHV1_POOL_SCHED
+	if (sched) {
+		struct sched_param param;
+		param.sched_priority = (sched & 0xffff);
+		return (::pthread_setschedparam(::pthread_self(),
+			(sched >> 16), &param) == 0);
+	}
+#endif
+	return (sched == 0);
+}
+
+
+//-------------------------------------------------------------------------
+// synthv1_pool_thread - worker thread decl.
+//
+
+class synthv1_pool_thread : public QThread
+{
+public:
+
+	// ctor.
+	synthv1_pool_thread(synthv1_pool *pool,
+		QMutex *mutex, QWaitCondition *cond, volatile bool *running)
+		: QThread(), m_pool(pool),
+			m_mutex(mutex), m_cond(cond), m_running(running),
+			m_sched(0), m_sched_ok(true) {}
+
+protected:
+
+	// main thread executive.
+	void run();
+
+private:
+
+	// pool instance reference.
+	synthv1_pool *m_pool;
+
+	// thread synchronization objects.
+	QMutex *m_mutex;
+	QWaitCondition *m_cond;
+
+	// whether the pool is logically running.
+	volatile bool *m_running;
+
+	// current (followed) scheduling and whether it was granted.
+	int  m_sched;
+	bool m_sched_ok;
+};
+
+
+//-------------------------------------------------------------------------
+// synthv1_pool - real-time worker thread pool impl.
+//
+
+// ctor.
+synthv1_pool::synthv1_pool ( uint16_t nthreads )
+	: m_nthreads(nthreads), m_threads(nullptr), m_running(true),
+		m_job(nullptr), m_nslices(0), m_gen(0),
+		m_wait_job(nullptr), m_wait_nslices(0), m_wait_gen(0),
+		m_ticket(0), m_ndone(0), m_sched(0)
+{
+	if (m_nthreads > 0) {
+		m_threads = new synthv1_pool_thread * [m_nthreads];
+		for (uint16_t i = 0; i < m_nthreads; ++i) {
+			m_threads[i] = new synthv1_pool_thread(this,
+				&m_mutex, &m_cond, &m_running);
+			m_threads[i]->start(QThread::TimeCriticalPriority);
+		}
+	}
+}
+
+
+// dtor.
+synthv1_pool::~synthv1_pool (void)
+{
+	if (m_threads) {
+		m_mutex.lock();
+		m_running = false;
+		m_cond.wakeAll();
+		m_mutex.unlock();
+		for (uint16_t i = 0; i < m_nthreads; ++i) {
+			m_threads[i]->wait();
+			delete m_threads[i];
+		}
+		delete [] m_threads;
+	}
+}
+
+
+// run job slices across all threads (caller included).
+void synthv1_pool::process ( Job *job, uint32_t nslices )
+{
+	start(job, nslices);
+	wait();
+}
+
+
+// start job slices across worker threads (caller excluded).
+void synthv1_pool::start ( Job *job, uint32_t nslices )
+{
+	if (nslices < 1)
+		return;
+
+	sched_caller();
+
+	const uint32_t gen = m_gen + 1;
+
+	m_wait_job = job;
+	m_wait_nslices = nslices;
+	m_wait_gen = gen;
+
+	m_ndone.store(0, std::memory_order_relaxed);
+	m_ticket.store(uint64_t(gen) << 32, std::memory_order_release);
+
+	// wake up workers, if not busy; otherwise we do it all alone
+	// (an unpublished generation is just reused next time around)...
+	if (m_threads && m_mutex.tryLock()) {
+		m_job = job;
+		m_nslices = nslices;
+		m_gen = gen;
+		m_cond.wakeAll();
+		m_mutex.unlock();
+	}
+}
+
+
+// wait for the started job slices (caller runs the leftovers).
+void synthv1_pool::wait (void)
+{
+	const uint32_t nslices = m_wait_nslices;
+	if (nslices < 1)
+		return;
+
+	run_process(m_wait_gen, m_wait_job, nslices);
+
+	// wait for the stragglers...
+	while (m_ndone.load(std::memory_order_acquire) < nslices)
+		QThread::yieldCurrentThread();
+
+	m_wait_nslices = 0;
+}
+
+
+// run as many job slices as available for this generation.
+void synthv1_pool::run_process ( uint32_t gen, Job *job, uint32_t nslices )
+{
+	uint64_t ticket = m_ticket.load(std::memory_order_acquire);
+
+	while (uint32_t(ticket >> 32) == gen && uint32_t(ticket) < nslices) {
+		if (m_ticket.compare_exchange_weak(ticket, ticket + 1,
+				std::memory_order_acq_rel, std::memory_order_acquire)) {
+			job->process(uint32_t(ticket));
+			m_ndone.fetch_add(1, std::memory_order_release);
+			ticket = m_ticket.load(std::memory_order_acquire);
+		}
+	}
+}
+
+
+// caller's (audio thread) scheduling, for workers to follow.
+void synthv1_pool::sched_caller (void)
+{
+	if (m_threads == nullptr)
+		return;
+
+	const int sched = synthv1_pool_sched_self();
+	if (m_sched.load(std::memory_order_relaxed) != sched)
+		m_sched.store(sched, std::memory_order_relaxed);
+}
+
+
+//-------------------------------------------------------------------------
+// synthv1_pool_thread - worker thread impl.
+//
+
+// main thread executive.
+void synthv1_pool_thread::run (void)
+{
+	m_mutex->lock();
+
+	uint32_t gen = m_pool->m_gen;
+
+	while (*m_running) {
+		// wait for next job...
+		if (gen == m_pool->m_gen) {
+			m_cond->wait(m_mutex);
+			continue;
+		}
+		gen = m_pool->m_gen;
+		synthv1_pool::Job *job = m_pool->m_job;
+		const uint32_t nslices = m_pool->m_nslices;
+		m_mutex->unlock();
+		// follow the caller's real-time scheduling (same policy and
+		// priority); if that's denied, stay out of any real-time
+		// caller's work, lest it would spin waiting on a preempted
+		// worker: the caller just runs all the slices by itself...
+		const int sched = m_pool->sched();
+		if (m_sched != sched) {
+			m_sched = sched;
+			m_sched_ok = synthv1_pool_sched_set(sched);
+		}
+		// do whatever we must...
+		if (m_sched_ok)
+			m_pool->run_process(gen, job, nslices);
+		m_mutex->lock();
+	}
+
+	m_mutex->unlock();
+}
+
+
+// end of synthv1_pool.cpp
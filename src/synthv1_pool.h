@@ -0,0 +1,126 @@
+// synthv1_pool.h
+//
+/****************************************************************************
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __synthv1_pool_h
+#define __synthv1_pool_h
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include <QMutex>
+#include <QWaitCondition>
+
+// forward decls.
+class synthv1_pool_thread;
+
+
+//-------------------------------------------------------------------------
+// synthv1_pool - real-time worker thread pool.
+//
+
+class synthv1_pool
+{
+public:
+
+	// ctor.
+	synthv1_pool(uint16_t nthreads);
+
+	// dtor.
+	~synthv1_pool();
+
+	// total number of threads (including caller's).
+	uint16_t count() const
+		{ return m_nthreads + 1; }
+
+	// Job - pool work item (pure virtual).
+	//
+	class Job
+	{
+	public:
+
+		// virtual dtor.
+		virtual ~Job() {}
+
+		// (pure) virtual processor.
+		virtual void process(uint32_t index) = 0;
+	};
+
+	// run job slices [0, nslices) across all threads;
+	// the caller participates and returns when all are done.
+	void process(Job *job, uint32_t nslices);
+
+	// start job slices [0, nslices) on worker threads only, returning
+	// at once; wait() must follow, before any other job, where the
+	// caller runs whatever slices were left behind.
+	void start(Job *job, uint32_t nslices);
+	void wait();
+
+protected:
+
+	friend class synthv1_pool_thread;
+
+	// run as many job slices as available for this generation.
+	void run_process(uint32_t gen, Job *job, uint32_t nslices);
+
+	// caller's (audio thread) scheduling, for workers to follow.
+	void sched_caller();
+	int sched() const
+		{ return m_sched.load(std::memory_order_relaxed); }
+
+private:
+
+	// worker threads.
+	uint16_t m_nthreads;
+
+	synthv1_pool_thread **m_threads;
+
+	// whether the pool is logically running.
+	volatile bool m_running;
+
+	// current job (guarded by the mutex).
+	Job     *m_job;
+	uint32_t m_nslices;
+	uint32_t m_gen;
+
+	// started job, still to wait for (caller's).
+	Job     *m_wait_job;
+	uint32_t m_wait_nslices;
+	uint32_t m_wait_gen;
+
+	// thread synchronization objects.
+	QMutex m_mutex;
+	QWaitCondition m_cond;
+
+	// generation (high 32 bit) and next slice (low 32 bit) ticket,
+	// so that late workers can't steal slices from a newer job.
+	std::atomic<uint64_t> m_ticket;
+	std::atomic<uint32_t> m_ndone;
+
+	// caller's real-time scheduling policy (high 16 bit) and priority
+	// (low 16 bit); zero when not real-time (or unknown).
+	std::atomic<int> m_sched;
+};
+
+
+#endif	// __synthv1_pool_h
+
+// end of synthv1_pool.h
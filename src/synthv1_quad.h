@@ -0,0 +1,137 @@
+// synthv1_quad.h
+//
+/****************************************************************************
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __synthv1_quad_h
+#define __synthv1_quad_h
+
+#include <cstdint>
+#include <cstring>
+
+
+//-------------------------------------------------------------------------
+// synthv1_quad - four float lanes, in one SIMD register (SSE/NEON).
+//
+// (generic compiler vector extension: element-wise arithmetic
+//  and lane subscripts; scalar operands are broadcast to all lanes)
+
+typedef float synthv1_quad __attribute__ ((vector_size (16)));
+
+
+inline synthv1_quad synthv1_quad_set (
+	const float x0, const float x1, const float x2, const float x3 )
+{
+	const synthv1_quad q = { x0, x1, x2, x3 };
+	return q;
+}
+
+
+inline synthv1_quad synthv1_quad_dup ( const float x )
+{
+	return synthv1_quad_set(x, x, x, x);
+}
+
+
+// swap adjacent lane pairs (0 <-> 1, 2 <-> 3).
+
+inline synthv1_quad synthv1_quad_swap ( const synthv1_quad& q )
+{
+	return synthv1_quad_set(q[1], q[0], q[3], q[2]);
+}
+
+
+// merge lower lane pair (0, 1) from q1 and upper (2, 3) from q2.
+
+inline synthv1_quad synthv1_quad_merge (
+	const synthv1_quad& q1, const synthv1_quad& q2 )
+{
+	return synthv1_quad_set(q1[0], q1[1], q2[2], q2[3]);
+}
+
+
+// integer lanes (comparison masks, bit patterns).
+
+typedef int32_t synthv1_quadi __attribute__ ((vector_size (16)));
+
+
+inline synthv1_quadi synthv1_quad_bits ( const synthv1_quad& q )
+{
+	synthv1_quadi i; ::memcpy(&i, &q, sizeof(i)); return i;
+}
+
+inline synthv1_quad synthv1_quad_from_bits ( const synthv1_quadi& i )
+{
+	synthv1_quad q; ::memcpy(&q, &i, sizeof(q)); return q;
+}
+
+
+// lane-wise select (mask lanes are all ones or all zeros).
+
+inline synthv1_quad synthv1_quad_select (
+	const synthv1_quadi& mask, const synthv1_quad& a, const synthv1_quad& b )
+{
+	return synthv1_quad_from_bits((mask & synthv1_quad_bits(a))
+		| (~mask & synthv1_quad_bits(b)));
+}
+
+
+// lane-wise clamp.
+
+inline synthv1_quad synthv1_quad_clamp (
+	const synthv1_quad& x, const float x0, const float x1 )
+{
+	const synthv1_quad lo = synthv1_quad_dup(x0);
+	const synthv1_quad hi = synthv1_quad_dup(x1);
+	const synthv1_quad y = synthv1_quad_select(x < lo, lo, x);
+	return synthv1_quad_select(y > hi, hi, y);
+}
+
+
+// lane shuffle (indexes 0-3 from a, 4-7 from b).
+
+#if defined(__clang__)
+#define SYNTHV1_QUAD_SHUFFLE(a, b, i0, i1, i2, i3) \
+	__builtin_shufflevector(a, b, i0, i1, i2, i3)
+#else
+#define SYNTHV1_QUAD_SHUFFLE(a, b, i0, i1, i2, i3) \
+	__builtin_shuffle(a, b, synthv1_quadi{i0, i1, i2, i3})
+#endif
+
+
+// 4x4 transpose, in place (lanes of four quads to four quads of lanes).
+
+inline void synthv1_quad_transpose (
+	synthv1_quad& q0, synthv1_quad& q1, synthv1_quad& q2, synthv1_quad& q3 )
+{
+	const synthv1_quad t0 = SYNTHV1_QUAD_SHUFFLE(q0, q1, 0, 4, 1, 5);
+	const synthv1_quad t1 = SYNTHV1_QUAD_SHUFFLE(q2, q3, 0, 4, 1, 5);
+	const synthv1_quad t2 = SYNTHV1_QUAD_SHUFFLE(q0, q1, 2, 6, 3, 7);
+	const synthv1_quad t3 = SYNTHV1_QUAD_SHUFFLE(q2, q3, 2, 6, 3, 7);
+
+	q0 = SYNTHV1_QUAD_SHUFFLE(t0, t1, 0, 1, 4, 5);
+	q1 = SYNTHV1_QUAD_SHUFFLE(t0, t1, 2, 3, 6, 7);
+	q2 = SYNTHV1_QUAD_SHUFFLE(t2, t3, 0, 1, 4, 5);
+	q3 = SYNTHV1_QUAD_SHUFFLE(t2, t3, 2, 3, 6, 7);
+}
+
+
+#endif	// __synthv1_quad_h
+
+// end of synthv1_quad.h
@@ -1,7 +1,7 @@
 // synthv1_ramp.h
 //
 /****************************************************************************
-   Copyright (C) 2012-2021, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -33,25 +33,20 @@ class synthv1_ramp
 {
 public:
 
+	// max. number of values (in-place, no heap)
+	static const uint16_t MAX_VALUES = 2;
+
 	synthv1_ramp(uint16_t nvalues = 1)
 	{
-		m_nvalues = nvalues;
-		m_value0 = new float [m_nvalues];
-		m_value1 = new float [m_nvalues];
-		m_delta  = new float [m_nvalues];
+		m_nvalues = (nvalues < MAX_VALUES ? nvalues : MAX_VALUES);
 
-		for (uint16_t i = 0; i < m_nvalues; ++i)
+		for (uint16_t i = 0; i < MAX_VALUES; ++i)
 			m_value0[i] = m_value1[i] = m_delta[i] = 0.0f;
 
 		m_frames = 0;
 	}
 
-	virtual ~synthv1_ramp()
-	{
-		delete [] m_delta;
-		delete [] m_value1;
-		delete [] m_value0;
-	}
+	virtual ~synthv1_ramp() {}
 
 	void reset()
 	{
@@ -98,9 +93,9 @@ private:
 
 	uint16_t m_nvalues;
 
-	float   *m_value1;
-	float   *m_value0;
-	float   *m_delta;
+	float    m_value1[MAX_VALUES];
+	float    m_value0[MAX_VALUES];
+	float    m_delta[MAX_VALUES];
 
 	uint32_t m_frames;
 };
@@ -0,0 +1,472 @@
+// synthv1_render.cpp
+//
+/****************************************************************************
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "synthv1.h"
+#include "synthv1_param.h"
+#include "synthv1_sched.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+
+//-------------------------------------------------------------------------
+// synthv1_render - headless engine instance decl.
+//
+
+class synthv1_render : public synthv1
+{
+public:
+
+	synthv1_render(uint16_t nvoices, float srate, uint32_t nsize)
+		: synthv1(2, srate, nsize, nvoices)
+	{
+		for (int i = 0; i < synthv1::NUM_PARAMS; ++i) {
+			const synthv1::ParamIndex index = synthv1::ParamIndex(i);
+			m_params[i] = synthv1_param::paramDefaultValue(index);
+			synthv1::setParamPort(index, &m_params[i]);
+		}
+
+		// engine options pinned to defaults, never inherited from
+		// user settings (/Engine), for a reproducible output; no
+		// effects pipeline, hence no latency to compensate either.
+		synthv1::setVoiceThreads(0);
+		synthv1::setVoiceSteal(synthv1::StealNone);
+		synthv1::setControlRate(0);
+		synthv1::setCpuLevel(synthv1::CpuAuto);
+		synthv1::setInterpolation(synthv1::InterpLinear);
+		synthv1::setOversampling(synthv1::Oversample1x);
+		synthv1::setWidthMorph(false);
+		synthv1::setFxPipeline(0);
+
+		synthv1::reset();
+	}
+
+	void updatePreset(bool) {}
+	void updateParam(synthv1::ParamIndex) {}
+	void updateParams() {}
+	void updateTuning() {}
+
+private:
+
+	float m_params[synthv1::NUM_PARAMS];
+};
+
+
+//-------------------------------------------------------------------------
+// synthv1_render - Standard MIDI File (SMF) reader.
+//
+
+struct synthv1_render_event
+{
+	uint64_t frame;		// absolute time (frames)
+	uint32_t tick;		// absolute time (ticks)
+	uint32_t tempo;		// tempo change (usecs/quarter; 0 = none)
+	uint8_t  data[3];	// channel message
+	uint8_t  size;
+};
+
+
+// big-endian integer.
+static uint32_t smf_read_int ( const uint8_t *p, uint32_t n )
+{
+	uint32_t ret = 0;
+	for (uint32_t i = 0; i < n; ++i)
+		ret = (ret << 8) | p[i];
+	return ret;
+}
+
+
+// variable length quantity.
+static bool smf_read_vlq ( const uint8_t *&p, const uint8_t *end, uint32_t& ret )
+{
+	ret = 0;
+	for (int i = 0; i < 4 && p < end; ++i) {
+		const uint8_t c = *p++;
+		ret = (ret << 7) | (c & 0x7f);
+		if ((c & 0x80) == 0)
+			return true;
+	}
+	return false;
+}
+
+
+// read all tracks, merged into one event list (in time order);
+// returns false on any error.
+static bool smf_read ( const char *pszFilename, float srate,
+	std::vector<synthv1_render_event>& events )
+{
+	FILE *fp = ::fopen(pszFilename, "rb");
+	if (fp == nullptr)
+		return false;
+
+	std::vector<uint8_t> buf;
+	uint8_t chunk[4096];
+	size_t nread;
+	while ((nread = ::fread(chunk, 1, sizeof(chunk), fp)) > 0)
+		buf.insert(buf.end(), chunk, chunk + nread);
+	::fclose(fp);
+
+	const uint8_t *p = buf.data();
+	const uint8_t *end = p + buf.size();
+
+	// header chunk.
+	if (end - p < 14 || ::memcmp(p, "MThd", 4) != 0)
+		return false;
+
+	const uint32_t hlen = smf_read_int(p + 4, 4);
+	if (hlen < 6 || uint32_t(end - p) < 8 + hlen)
+		return false;
+
+	const uint16_t ntracks  = smf_read_int(p + 10, 2);
+	const uint16_t division = smf_read_int(p + 12, 2);
+	if (division == 0)
+		return false;
+
+	p += 8 + hlen;
+
+	// track chunks.
+	for (uint16_t itrack = 0; itrack < ntracks && end - p >= 8; ++itrack) {
+		const uint32_t tlen = smf_read_int(p + 4, 4);
+		if (uint32_t(end - p - 8) < tlen)
+			return false;
+		const bool mtrk = (::memcmp(p, "MTrk", 4) == 0);
+		const uint8_t *q = p + 8;
+		const uint8_t *qend = q + tlen;
+		p = qend;
+		if (!mtrk) // skip alien chunks.
+			continue;
+		uint32_t tick = 0;
+		uint8_t status = 0;
+		while (q < qend) {
+			uint32_t delta;
+			if (!smf_read_vlq(q, qend, delta))
+				return false;
+			tick += delta;
+			if (q >= qend)
+				return false;
+			uint8_t c = *q;
+			if (c & 0x80) {
+				++q;
+				if (c < 0xf0)
+					status = c; // running status
+			} else if (status == 0) {
+				return false;
+			} else {
+				c = status;
+			}
+			if (c == 0xff) {
+				// meta event.
+				if (q >= qend)
+					return false;
+				const uint8_t type = *q++;
+				uint32_t len;
+				if (!smf_read_vlq(q, qend, len) || uint32_t(qend - q) < len)
+					return false;
+				if (type == 0x51 && len == 3) {
+					synthv1_render_event ev;
+					::memset(&ev, 0, sizeof(ev));
+					ev.tick  = tick;
+					ev.tempo = smf_read_int(q, 3);
+					events.push_back(ev);
+				}
+				q += len;
+				status = 0;
+				if (type == 0x2f) // end of track.
+					break;
+			}
+			else
+			if (c == 0xf0 || c == 0xf7) {
+				// sysex (skipped).
+				uint32_t len;
+				if (!smf_read_vlq(q, qend, len) || uint32_t(qend - q) < len)
+					return false;
+				q += len;
+				status = 0;
+			}
+			else
+			if (c >= 0x80 && c < 0xf0) {
+				// channel message.
+				const uint8_t size = ((c & 0xe0) == 0xc0 ? 2 : 3);
+				if (uint32_t(qend - q) < uint32_t(size - 1))
+					return false;
+				synthv1_render_event ev;
+				::memset(&ev, 0, sizeof(ev));
+				ev.tick = tick;
+				ev.size = size;
+				ev.data[0] = c;
+				ev.data[1] = q[0];
+				if (size > 2)
+					ev.data[2] = q[1];
+				q += size - 1;
+				events.push_back(ev);
+			}
+			else return false;
+		}
+	}
+
+	// merge tracks, keeping same tick events in track order.
+	std::stable_sort(events.begin(), events.end(),
+		[] (const synthv1_render_event& a, const synthv1_render_event& b)
+			{ return a.tick < b.tick; });
+
+	// ticks to frames, following the tempo map.
+	double secs_per_tick;
+	if (division & 0x8000) {
+		// SMPTE: frames/sec and ticks/frame.
+		const int fps = -int(int8_t(division >> 8));
+		const double rate = (fps == 29 ? 29.97 : double(fps));
+		secs_per_tick = 1.0 / (rate * double(division & 0xff));
+	} else {
+		// PPQN: 120bpm default tempo.
+		secs_per_tick = 0.5 / double(division);
+	}
+
+	double secs = 0.0;
+	uint32_t tick0 = 0;
+	for (synthv1_render_event& ev : events) {
+		secs += double(ev.tick - tick0) * secs_per_tick;
+		tick0 = ev.tick;
+		ev.frame = uint64_t(::llround(secs * double(srate)));
+		if (ev.tempo > 0 && (division & 0x8000) == 0)
+			secs_per_tick = 1e-6 * double(ev.tempo) / double(division);
+	}
+
+	return true;
+}
+
+
+//-------------------------------------------------------------------------
+// synthv1_render - RIFF/WAVE file writer (16 bit PCM or 32 bit float).
+//
+
+static void wav_write_int ( FILE *fp, uint32_t value, uint32_t n )
+{
+	for (uint32_t i = 0; i < n; ++i) {
+		::fputc(int(value & 0xff), fp);
+		value >>= 8;
+	}
+}
+
+
+static void wav_write_header ( FILE *fp, uint16_t nchannels,
+	uint32_t srate, uint16_t nbits, uint64_t nframes )
+{
+	const uint16_t format = (nbits == 32 ? 3 : 1); // float or PCM
+	const uint32_t nbytes = uint32_t(nframes * nchannels * (nbits >> 3));
+
+	::fwrite("RIFF", 1, 4, fp);
+	wav_write_int(fp, 36 + nbytes, 4);
+	::fwrite("WAVE", 1, 4, fp);
+	::fwrite("fmt ", 1, 4, fp);
+	wav_write_int(fp, 16, 4);
+	wav_write_int(fp, format, 2);
+	wav_write_int(fp, nchannels, 2);
+	wav_write_int(fp, srate, 4);
+	wav_write_int(fp, srate * nchannels * (nbits >> 3), 4);
+	wav_write_int(fp, nchannels * (nbits >> 3), 2);
+	wav_write_int(fp, nbits, 2);
+	::fwrite("data", 1, 4, fp);
+	wav_write_int(fp, nbytes, 4);
+}
+
+
+static void wav_write_frames ( FILE *fp, float **outs,
+	uint16_t nchannels, uint16_t nbits, uint32_t nframes )
+{
+	for (uint32_t n = 0; n < nframes; ++n) {
+		for (uint16_t k = 0; k < nchannels; ++k) {
+			const float x = outs[k][n];
+			if (nbits == 32) {
+				uint32_t u;
+				::memcpy(&u, &x, sizeof(u));
+				wav_write_int(fp, u, 4);
+			} else {
+				const float y = (x > 1.0f ? 1.0f : (x < -1.0f ? -1.0f : x));
+				wav_write_int(fp, uint16_t(int16_t(::lrintf(32767.0f * y))), 2);
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------------------------------
+// main.
+//
+
+static void usage ( const char *arg0 )
+{
+	::fprintf(stderr, "usage: %s [-p preset] [-r srate] [-n frames]"
+		" [-v voices] [-t tail-secs] [-b 16|32] in.mid out.wav\n", arg0);
+}
+
+
+int main ( int argc, char *argv[] )
+{
+	const char *preset  = nullptr;
+	const char *midi_in = nullptr;
+	const char *wav_out = nullptr;
+
+	float    srate   = 48000.0f;
+	uint32_t nframes = 256;
+	int      nvoices = 64;
+	float    tail    = 2.0f;
+	uint16_t nbits   = 32;
+
+	for (int i = 1; i < argc; ++i) {
+		if (::strcmp(argv[i], "-p") == 0 && i < argc - 1)
+			preset = argv[++i];
+		else
+		if (::strcmp(argv[i], "-r") == 0 && i < argc - 1)
+			srate = float(::atof(argv[++i]));
+		else
+		if (::strcmp(argv[i], "-n") == 0 && i < argc - 1)
+			nframes = uint32_t(::atoi(argv[++i]));
+		else
+		if (::strcmp(argv[i], "-v") == 0 && i < argc - 1)
+			nvoices = ::atoi(argv[++i]);
+		else
+		if (::strcmp(argv[i], "-t") == 0 && i < argc - 1)
+			tail = float(::atof(argv[++i]));
+		else
+		if (::strcmp(argv[i], "-b") == 0 && i < argc - 1)
+			nbits = (::atoi(argv[++i]) == 16 ? 16 : 32);
+		else
+		if (argv[i][0] != '-' && midi_in == nullptr)
+			midi_in = argv[i];
+		else
+		if (argv[i][0] != '-' && wav_out == nullptr)
+			wav_out = argv[i];
+		else {
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (midi_in == nullptr || wav_out == nullptr
+		|| srate < 1.0f || nframes < 1 || tail < 0.0f
+		|| nvoices < 1 || nvoices > 256) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	std::vector<synthv1_render_event> events;
+	if (!smf_read(midi_in, srate, events)) {
+		::fprintf(stderr, "%s: invalid MIDI file.\n", midi_in);
+		return 2;
+	}
+
+	synthv1_render synth(uint16_t(nvoices), srate, nframes);
+
+	if (preset && !synthv1_param::loadPreset(&synth, preset)) {
+		::fprintf(stderr, "%s: could not load preset.\n", preset);
+		return 2;
+	}
+
+	FILE *fp = ::fopen(wav_out, "wb");
+	if (fp == nullptr) {
+		::fprintf(stderr, "%s: could not open for writing.\n", wav_out);
+		return 2;
+	}
+
+	const uint16_t nchannels = synth.channels();
+
+	const uint64_t nframes_total
+		= (events.empty() ? 0 : events.back().frame)
+		+ uint64_t(tail * srate);
+
+	wav_write_header(fp, nchannels, uint32_t(srate), nbits, nframes_total);
+
+	std::vector<float> bufs(2 * nchannels * nframes, 0.0f);
+	std::vector<float *> ins(nchannels), outs(nchannels), v_ins(nchannels), v_outs(nchannels);
+	for (uint16_t k = 0; k < nchannels; ++k) {
+		ins[k]  = &bufs[k * nframes];
+		outs[k] = &bufs[(nchannels + k) * nframes];
+	}
+
+	synth.stabilize();
+
+	// pre-roll: let the preset wave tables in, before the first event,
+	// for a deterministic output; one silent cycle schedules them, all
+	// pending get generated right away, and the next cycle swaps them in.
+	synth.process(ins.data(), outs.data(), nframes);
+	synthv1_sched::sync_pending();
+	synth.process(ins.data(), outs.data(), nframes);
+
+	const auto t0 = std::chrono::steady_clock::now();
+
+	// render in blocks, split at each event time (as JACK does)...
+	size_t ievent = 0;
+	for (uint64_t frame = 0; frame < nframes_total; frame += nframes) {
+		uint32_t nblock = nframes;
+		if (frame + nblock > nframes_total)
+			nblock = uint32_t(nframes_total - frame);
+		for (uint16_t k = 0; k < nchannels; ++k) {
+			v_ins[k]  = ins[k];
+			v_outs[k] = outs[k];
+		}
+		uint32_t ndelta = 0;
+		for ( ; ievent < events.size()
+				&& events[ievent].frame < frame + nblock; ++ievent) {
+			synthv1_render_event& ev = events[ievent];
+			const uint32_t event_time = uint32_t(ev.frame - frame);
+			if (event_time > ndelta) {
+				const uint32_t nread = event_time - ndelta;
+				synth.process(v_ins.data(), v_outs.data(), nread);
+				for (uint16_t k = 0; k < nchannels; ++k) {
+					v_ins[k]  += nread;
+					v_outs[k] += nread;
+				}
+				ndelta = event_time;
+			}
+			if (ev.tempo > 0)
+				synth.setTempo(60e6f / float(ev.tempo));
+			if (ev.size > 0)
+				synth.process_midi(ev.data, ev.size);
+		}
+		if (nblock > ndelta)
+			synth.process(v_ins.data(), v_outs.data(), nblock - ndelta);
+		wav_write_frames(fp, outs.data(), nchannels, nbits, nblock);
+	}
+
+	const auto t1 = std::chrono::steady_clock::now();
+
+	::fclose(fp);
+
+	const double render_secs
+		= std::chrono::duration<double>(t1 - t0).count();
+	const double audio_secs
+		= double(nframes_total) / double(srate);
+
+	::printf("%s: %.3f secs audio, rendered in %.3f secs"
+		" (realtime factor %.2fx)\n", wav_out, audio_secs, render_secs,
+		(render_secs > 0.0 ? audio_secs / render_secs : 0.0));
+
+	return 0;
+}
+
+
+// end of synthv1_render.cpp
@@ -1,7 +1,7 @@
 // synthv1_reverb.h
 //
 /****************************************************************************
-   Copyright (C) 2012-2021, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -22,6 +22,9 @@
 #ifndef __synthv1_reverb_h
 #define __synthv1_reverb_h
 
+#include "synthv1_quad.h"
+#include "synthv1_fx.h"
+
 #include <cstdint>
 #include <cstring>
 
@@ -32,6 +35,10 @@
 // -- borrowed, stirred and refactored from original FreeVerb --
 //    by Jezar at Dreampoint, June 2000 (public domain)
 //
+// processed in chunks, short of any delay line wrap-around: the comb
+// filters run four at a time, as quad lanes (left and right networks
+// interleaved), the allpass filters one stage at a time over the chunk.
+//
 
 class synthv1_reverb
 {
@@ -57,25 +64,53 @@ public:
 
 		uint32_t j;
 
+		// longest tail: last comb, then all allpass filters in series.
+		m_ntail = 0;
+
 		for (j = 0; j < NUM_ALLPASSES; ++j) {
 			m_allpass0[j].resize(uint32_t(s_allpass[j] * sr));
-			m_allpass0[j].reset();
-			m_allpass1[j].resize(uint32_t((s_allpass[j] + STEREO_SPREAD) * sr));
-			m_allpass1[j].reset();
+			const uint32_t nsize = uint32_t((s_allpass[j] + STEREO_SPREAD) * sr);
+			m_allpass1[j].resize(nsize);
+			m_ntail += nsize;
 		}
 
 		for (j = 0; j < NUM_COMBS; ++j) {
 			m_comb0[j].resize(uint32_t(s_comb[j] * sr));
-			m_comb0[j].reset();
 			m_comb1[j].resize(uint32_t((s_comb[j] + STEREO_SPREAD) * sr));
-			m_comb1[j].reset();
 		}
 
+		m_ntail += uint32_t((s_comb[NUM_COMBS - 1] + STEREO_SPREAD) * sr);
+
+		clear();
+
+		m_tail.reset();
+
 		reset_feedb();
 		reset_room();
 		reset_damp();
 	}
 
+	void clear()
+	{
+		uint32_t j;
+
+		for (j = 0; j < NUM_ALLPASSES; ++j) {
+			m_allpass0[j].reset();
+			m_allpass1[j].reset();
+		}
+
+		for (j = 0; j < NUM_COMBS; ++j) {
+			m_comb0[j].reset();
+			m_comb1[j].reset();
+		}
+
+		for (j = 0; j < NUM_COMB_QUADS; ++j)
+			m_comb_out[j] = synthv1_quad_dup(0.0f);
+	}
+
+	bool isDormant() const
+		{ return m_tail.isDormant(); }
+
 	void process(float *in0, float *in1, uint32_t nframes,
 		float wet, float feedb, float room, float damp, float width)
 	{
@@ -97,37 +132,41 @@ public:
 			reset_damp();
 		}
 
-		uint32_t i, j;
+		// dormant?
+		if (m_tail.bypass(in0, in1, nframes))
+			return;
 
-		for (i = 0; i < nframes; ++i) {
+		const uint32_t nframes0 = nframes;
+		float peak = 0.0f;
+
+		uint32_t j;
 
-			float out0 = *in0 * 0.05f; // 0.015f;
-			float out1 = *in1 * 0.05f; // 0.015f;
+		while (nframes > 0) {
 
-			float tmp0 = 0.0f;
-			float tmp1 = 0.0f;
+			uint32_t nchunk = (nframes < MAX_CHUNK ? nframes : MAX_CHUNK);
 
 			for (j = 0; j < NUM_COMBS; ++j) {
-				tmp0 += m_comb0[j].output(out0);
-				tmp1 += m_comb1[j].output(out1);
+				nchunk = m_comb0[j].contiguous(nchunk);
+				nchunk = m_comb1[j].contiguous(nchunk);
 			}
 
 			for (j = 0; j < NUM_ALLPASSES; ++j) {
-				tmp0 = m_allpass0[j].output(tmp0);
-				tmp1 = m_allpass1[j].output(tmp1);
+				nchunk = m_allpass0[j].contiguous(nchunk);
+				nchunk = m_allpass1[j].contiguous(nchunk);
 			}
 
-			if (width < 0.0f) {
-				out0 = tmp0 * (1.0f + width) - tmp1 * width;
-				out1 = tmp1 * (1.0f + width) - tmp0 * width;
-			} else {
-				out0 = tmp0 * width + tmp1 * (1.0f - width);
-				out1 = tmp1 * width + tmp0 * (1.0f - width);
-			}
+			const float peak1 = process_chunk(in0, in1, nchunk, wet, width);
+			if (peak < peak1)
+				peak = peak1;
 
-			*in0++ += wet * out0;
-			*in1++ += wet * out1;
+			in0 += nchunk;
+			in1 += nchunk;
+			nframes -= nchunk;
 		}
+
+		// tail decayed?
+		if (m_tail.update(peak, nframes0, m_ntail))
+			clear();
 	}
 
 protected:
@@ -136,21 +175,139 @@ protected:
 	static const uint32_t NUM_ALLPASSES = 6;
 	static const uint32_t STEREO_SPREAD = 23;
 
-	void reset_room()
+	static const uint32_t NUM_COMB_QUADS = NUM_COMBS / 2;
+	static const uint32_t MAX_CHUNK      = 64;
+
+	// returns the (dry) output peak.
+	float process_chunk(float *in0, float *in1, uint32_t nframes,
+		float wet, float width)
 	{
-		for (uint32_t j = 0; j < NUM_COMBS; ++j) {
-			m_comb0[j].set_feedb(m_room);
-			m_comb1[j].set_feedb(m_room);
+		synthv1_quad ins[MAX_CHUNK];
+		synthv1_quad outs[MAX_CHUNK];
+
+		float tmp0[MAX_CHUNK];
+		float tmp1[MAX_CHUNK];
+
+		uint32_t i, j;
+
+		for (i = 0; i < nframes; ++i) {
+			const float x0 = in0[i] * 0.05f; // 0.015f;
+			const float x1 = in1[i] * 0.05f; // 0.015f;
+			ins[i] = synthv1_quad_set(x0, x1, x0, x1);
+			outs[i] = synthv1_quad_dup(0.0f);
+		}
+
+		// comb filters (lanes: left, right, next left, next right),
+		// all quads at once, their damping feedback chains being serial.
+		const float feedb = m_comb_feedb;
+		const float damp0 = m_comb_damp;
+		const float damp1 = 1.0f - damp0;
+
+		float *bufs[NUM_COMB_QUADS][4];
+		synthv1_quad outs1[NUM_COMB_QUADS];
+
+		for (j = 0; j < NUM_COMB_QUADS; ++j) {
+			bufs[j][0] = m_comb0[2 * j].head();
+			bufs[j][1] = m_comb1[2 * j].head();
+			bufs[j][2] = m_comb0[2 * j + 1].head();
+			bufs[j][3] = m_comb1[2 * j + 1].head();
+			outs1[j] = m_comb_out[j];
+		}
+
+		// (four frames at a time, transposed to lanes and back)
+		for (i = 0; i + 4 <= nframes; i += 4) {
+			synthv1_quad x[NUM_COMB_QUADS][4];
+			for (j = 0; j < NUM_COMB_QUADS; ++j) {
+				for (uint32_t k = 0; k < 4; ++k)
+					::memcpy(&x[j][k], bufs[j][k] + i, sizeof(synthv1_quad));
+				synthv1_quad_transpose(x[j][0], x[j][1], x[j][2], x[j][3]);
+			}
+			for (uint32_t k = 0; k < 4; ++k) {
+				synthv1_quad out = outs[i + k];
+				for (j = 0; j < NUM_COMB_QUADS; ++j) {
+					synthv1_quad& out1 = outs1[j];
+					out += x[j][k];
+					out1 = denormal(x[j][k] * damp1 + out1 * damp0);
+					x[j][k] = ins[i + k] + out1 * feedb;
+				}
+				outs[i + k] = out;
+			}
+			for (j = 0; j < NUM_COMB_QUADS; ++j) {
+				synthv1_quad_transpose(x[j][0], x[j][1], x[j][2], x[j][3]);
+				for (uint32_t k = 0; k < 4; ++k)
+					::memcpy(bufs[j][k] + i, &x[j][k], sizeof(synthv1_quad));
+			}
+		}
+
+		for (; i < nframes; ++i) {
+			synthv1_quad out = outs[i];
+			for (j = 0; j < NUM_COMB_QUADS; ++j) {
+				float **buf = bufs[j];
+				const synthv1_quad x = synthv1_quad_set(
+					buf[0][i], buf[1][i], buf[2][i], buf[3][i]);
+				synthv1_quad& out1 = outs1[j];
+				out += x;
+				out1 = denormal(x * damp1 + out1 * damp0);
+				const synthv1_quad y = ins[i] + out1 * feedb;
+				buf[0][i] = y[0];
+				buf[1][i] = y[1];
+				buf[2][i] = y[2];
+				buf[3][i] = y[3];
+			}
+			outs[i] = out;
 		}
+
+		for (j = 0; j < NUM_COMB_QUADS; ++j)
+			m_comb_out[j] = outs1[j];
+
+		for (j = 0; j < NUM_COMBS; ++j) {
+			m_comb0[j].advance(nframes);
+			m_comb1[j].advance(nframes);
+		}
+
+		for (i = 0; i < nframes; ++i) {
+			tmp0[i] = outs[i][0] + outs[i][2];
+			tmp1[i] = outs[i][1] + outs[i][3];
+		}
+
+		// allpass filters, in series
+		for (j = 0; j < NUM_ALLPASSES; ++j) {
+			m_allpass0[j].process(tmp0, nframes);
+			m_allpass1[j].process(tmp1, nframes);
+		}
+
+		float peak = 0.0f;
+
+		for (i = 0; i < nframes; ++i) {
+			float out0, out1;
+			if (width < 0.0f) {
+				out0 = tmp0[i] * (1.0f + width) - tmp1[i] * width;
+				out1 = tmp1[i] * (1.0f + width) - tmp0[i] * width;
+			} else {
+				out0 = tmp0[i] * width + tmp1[i] * (1.0f - width);
+				out1 = tmp1[i] * width + tmp0[i] * (1.0f - width);
+			}
+			in0[i] += wet * out0;
+			in1[i] += wet * out1;
+			const float p0 = ::fabsf(tmp0[i]);
+			const float p1 = ::fabsf(tmp1[i]);
+			if (peak < p0)
+				peak = p0;
+			if (peak < p1)
+				peak = p1;
+		}
+
+		return peak;
+	}
+
+	void reset_room()
+	{
+		m_comb_feedb = m_room;
 	}
 
 	void reset_damp()
 	{
-		const float damp2 = m_damp * m_damp;
-		for (uint32_t j = 0; j < NUM_COMBS; ++j) {
-			m_comb0[j].set_damp(damp2);
-			m_comb1[j].set_damp(damp2);
-		}
+		m_comb_damp = m_damp * m_damp;
 	}
 
 	void reset_feedb()
@@ -195,55 +352,28 @@ protected:
 			}
 		}
 
-		float *tick()
+		// frames up to the wrap-around (at most nframes).
+		uint32_t contiguous(uint32_t nframes) const
 		{
-			float *buf = m_buffer + m_index;
-			if (++m_index >= m_size)
-				m_index = 0;
-			return buf;
+			const uint32_t nfree = m_size - m_index;
+			return (nframes < nfree ? nframes : nfree);
 		}
 
-	private:
+		float *head() const
+			{ return m_buffer + m_index; }
 
-		float   *m_buffer;
-		uint32_t m_size;
-		uint32_t m_index;
-	};
-
-	class comb_filter : public sample_buffer
-	{
-	public:
-
-		comb_filter (uint32_t size = 0)
-			: sample_buffer(size), m_feedb(0.5f), m_damp(0.5f), m_out(0.0f) {}
-
-		void set_feedb(float feedb)
-			{ m_feedb = feedb; }
-		float feedb() const
-			{ return m_feedb; }
-
-		void set_damp(float damp)
-			{ m_damp = damp; }
-		float damp() const
-			{ return m_damp; }
-
-		void reset()
-			{ sample_buffer::reset(); m_out = 0.0f; }
-
-		float output(float in)
+		void advance(uint32_t nframes)
 		{
-			float *buf = tick();
-			float  out = *buf;
-			m_out = denormal(out * (1.0f - m_damp) + m_out * m_damp);
-			*buf = in + (m_out * m_feedb);
-			return out;
+			m_index += nframes;
+			if (m_index >= m_size)
+				m_index -= m_size;
 		}
 
 	private:
 
-		float m_feedb;
-		float m_damp;
-		float m_out;
+		float   *m_buffer;
+		uint32_t m_size;
+		uint32_t m_index;
 	};
 
 	class allpass_filter : public sample_buffer
@@ -258,12 +388,29 @@ protected:
 		float feedb () const
 			{ return m_feedb; }
 
-		float output(float in)
+		// in-place, short of wrap-around (see contiguous).
+		void process(float *inout, uint32_t nframes)
 		{
-			float *buf = tick();
-			float  out = *buf;
-			*buf = denormal(in + out * m_feedb);
-			return out - in;
+			float *buf = head();
+			const float feedb = m_feedb;
+			uint32_t i = 0;
+			// (four frames at a time)
+			for (; i + 4 <= nframes; i += 4) {
+				synthv1_quad in, out;
+				::memcpy(&in, inout + i, sizeof(in));
+				::memcpy(&out, buf + i, sizeof(out));
+				const synthv1_quad y = denormal(in + out * feedb);
+				const synthv1_quad z = out - in;
+				::memcpy(buf + i, &y, sizeof(y));
+				::memcpy(inout + i, &z, sizeof(z));
+			}
+			for (; i < nframes; ++i) {
+				const float in  = inout[i];
+				const float out = buf[i];
+				buf[i] = denormal(in + out * feedb);
+				inout[i] = out - in;
+			}
+			advance(nframes);
 		}
 
 	private:
@@ -278,6 +425,12 @@ protected:
 		return (u.w & 0x7f800000) ? v : 0.0f;
 	}
 
+	static synthv1_quad denormal(const synthv1_quad& v)
+	{
+		const synthv1_quadi w = synthv1_quad_bits(v);
+		return synthv1_quad_from_bits(w & ((w & 0x7f800000) != 0));
+	}
+
 private:
 
 	float m_srate;
@@ -286,11 +439,20 @@ private:
 	float m_damp;
 	float m_feedb;
 
-	comb_filter m_comb0[NUM_COMBS];
-	comb_filter m_comb1[NUM_COMBS];
+	float m_comb_feedb;
+	float m_comb_damp;
+
+	sample_buffer m_comb0[NUM_COMBS];
+	sample_buffer m_comb1[NUM_COMBS];
+
+	synthv1_quad m_comb_out[NUM_COMB_QUADS];
 
 	allpass_filter m_allpass0[NUM_ALLPASSES];
 	allpass_filter m_allpass1[NUM_ALLPASSES];
+
+	uint32_t m_ntail;
+
+	synthv1_fx_tail m_tail;
 };
 
 
@@ -1,7 +1,7 @@
 // synthv1_sched.cpp
 //
 /****************************************************************************
-   Copyright (C) 2012-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -51,6 +51,9 @@ public:
 	// clear all pending runs immediately.
 	void sync_reset();
 
+	// clear all pending runs of one, immediately.
+	void sync_cancel(synthv1_sched *sched);
+
 protected:
 
 	// main thread executive.
@@ -160,6 +163,20 @@ void synthv1_sched_thread::sync_reset (void)
 }
 
 
+// clear all pending runs of one, immediately.
+void synthv1_sched_thread::sync_cancel ( synthv1_sched *sched )
+{
+	QMutexLocker locker(&m_mutex);
+
+	uint32_t r = m_iread;
+	while (r != m_iwrite) {
+		if (m_items[r] == sched)
+			m_items[r] = nullptr;
+		r = (r + 1) & m_nmask;
+	}
+}
+
+
 void synthv1_sched_thread::clear (void)
 {
 	m_iread  = 0;
@@ -231,6 +248,8 @@ synthv1_sched::synthv1_sched ( synthv1 *pSynth, Type stype, uint32_t nsize )
 // dtor (virtual).
 synthv1_sched::~synthv1_sched (void)
 {
+	sync_cancel();
+
 	delete [] m_items;
 
 	if (--g_sched_refcount == 0) {
@@ -321,6 +340,14 @@ void synthv1_sched::sync_reset (void)
 }
 
 
+// clear own pending schedules, immediately.
+void synthv1_sched::sync_cancel (void)
+{
+	if (g_sched_thread)
+		g_sched_thread->sync_cancel(this);
+}
+
+
 //-------------------------------------------------------------------------
 // synthv1_sched::Notifier - worker/schedule proxy decl.
 //
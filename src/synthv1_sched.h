@@ -1,7 +1,7 @@
 // synthv1_sched.h
 //
 /****************************************************************************
-   Copyright (C) 2012-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -88,6 +88,10 @@ public:
 	static void sync_pending();
 	static void sync_reset();
 
+	// clear own pending schedules, immediately
+	// (and wait for any running one to finish).
+	void sync_cancel();
+
 private:
 
 	// instance variables.
@@ -1,7 +1,7 @@
 // synthv1_wave.cpp
 //
 /****************************************************************************
-   Copyright (C) 2012-2023, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -21,9 +21,14 @@
 
 #include "synthv1_wave.h"
 
+#include "config.h"
+
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
 
+#include <utility>
+
 
 //-------------------------------------------------------------------------
 // synthv1_wave_sched - local module schedule thread stuff.
@@ -36,13 +41,21 @@ class synthv1_wave_sched : public synthv1_sched
 {
 public:
 
+	// schedule ids.
+	enum { Reset = 0, Reclaim = 1 };
+
 	// ctor.
 	synthv1_wave_sched (synthv1_wave *wave)
 		: synthv1_sched(nullptr, Wave), m_wave(wave) {}
 
 	// process reset (virtual).
-	void process(int)
-		{ m_wave->reset_sync(); }
+	void process(int sid)
+	{
+		if (sid == Reclaim)
+			m_wave->reset_reclaim();
+		else
+			m_wave->reset_sync();
+	}
 
 private:
 
@@ -51,6 +64,703 @@ private:
 };
 
 
+//-------------------------------------------------------------------------
+// synthv1_wave_tables - shared wave tables (one set per unique wave).
+//
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QFile>
+
+
+struct synthv1_wave_key
+{
+	uint32_t nsize;
+	uint16_t nover;
+	uint16_t ntabs;
+	int      shape;
+	float    width;
+	bool     bandl;
+
+	bool operator== ( const synthv1_wave_key& key ) const
+	{
+		return nsize == key.nsize && nover == key.nover
+			&& ntabs == key.ntabs && shape == key.shape
+			&& width == key.width && bandl == key.bandl;
+	}
+};
+
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+inline uint qHash ( const synthv1_wave_key& key, uint seed = 0 )
+#else
+inline size_t qHash ( const synthv1_wave_key& key, size_t seed = 0 )
+#endif
+{
+	return qHash(key.width, seed)
+		^ (key.nsize << 12) ^ (key.nover << 6) ^ (key.ntabs << 3)
+		^ (key.shape << 1) ^ (key.bandl ? 1 : 0);
+}
+
+
+class synthv1_wave_tables
+{
+public:
+
+	// ctor.
+	synthv1_wave_tables ( const synthv1_wave_key& key, bool parts )
+		: m_key(key), m_parts(parts), m_phase0(0.0f), m_refcount(1),
+			m_file(nullptr), m_saved(false), m_settled(false), m_since(0)
+	{
+		const uint16_t ntabs = m_key.ntabs;
+		const uint32_t nsize = m_key.nsize + 4;
+
+		// no partials: all the band-limited slots alias the last one.
+		m_tables = new float * [ntabs + 1];
+		m_tables[ntabs] = new float [nsize];
+		for (uint16_t itab = 0; itab < ntabs; ++itab)
+			m_tables[itab] = (m_parts ? new float [nsize] : m_tables[ntabs]);
+	}
+
+	// ctor (read-only, memory-mapped from file).
+	synthv1_wave_tables ( const synthv1_wave_key& key, bool parts,
+		float phase0, QFile *file, float *frames )
+		: m_key(key), m_parts(parts), m_phase0(phase0), m_refcount(1),
+			m_file(file), m_saved(true), m_settled(false), m_since(0)
+	{
+		const uint16_t ntabs = m_key.ntabs;
+		const uint32_t nsize = m_key.nsize + 4;
+
+		// tables laid out contiguously, last one first.
+		m_tables = new float * [ntabs + 1];
+		m_tables[ntabs] = frames;
+		for (uint16_t itab = 0; itab < ntabs; ++itab)
+			m_tables[itab] = (m_parts ? frames + (itab + 1) * nsize : frames);
+	}
+
+	// dtor.
+	~synthv1_wave_tables ()
+	{
+		const uint16_t ntabs = m_key.ntabs;
+
+		if (m_file) {
+			// unmaps all.
+			delete m_file;
+		} else {
+			if (m_parts) {
+				for (uint16_t itab = 0; itab < ntabs; ++itab)
+					delete [] m_tables[itab];
+			}
+			delete [] m_tables[ntabs];
+		}
+		delete [] m_tables;
+	}
+
+	// accessors.
+	const synthv1_wave_key& key() const
+		{ return m_key; }
+	bool parts() const
+		{ return m_parts; }
+	float **tables() const
+		{ return m_tables; }
+
+	void setPhase0 ( float phase0 )
+		{ m_phase0 = phase0; }
+	float phase0() const
+		{ return m_phase0; }
+
+	// reference counting (under cache lock).
+	uint32_t addRef ()
+		{ return ++m_refcount; }
+	uint32_t release ()
+		{ return --m_refcount; }
+	uint32_t refcount() const
+		{ return m_refcount; }
+
+	// persistence state (under cache lock).
+	void setSaved ( bool saved )
+		{ m_saved = saved; }
+	bool saved() const
+		{ return m_saved; }
+
+	void setSettled ( bool settled )
+		{ m_settled = settled; }
+	bool settled() const
+		{ return m_settled; }
+
+	void setSince ( qint64 since )
+		{ m_since = since; }
+	qint64 since() const
+		{ return m_since; }
+
+private:
+
+	synthv1_wave_key m_key;
+	bool             m_parts;
+	float          **m_tables;
+	float            m_phase0;
+	uint32_t         m_refcount;
+	QFile           *m_file;
+	bool             m_saved;
+	bool             m_settled;
+	qint64           m_since;
+};
+
+
+//-------------------------------------------------------------------------
+// synthv1_wave_file - persistent (on-disk) wave tables cache.
+//
+// generated tables get saved under the user cache directory, one file
+// per unique wave, then memory-mapped (read-only) whenever asked for
+// again, by this or any later process; files from another generators
+// version (or otherwise mismatched) are ignored, and overwritten.
+// only band-limited sets are worth it (the plain ones are cheap to
+// generate anyway) and the least recently used files go first, over
+// a size budget (files get touched on every load).
+
+#ifdef CONFIG_WAVE_CACHE
+
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QDateTime>
+#include <QDir>
+
+
+class synthv1_wave_file
+{
+public:
+
+	// generators version; must be bumped on any change
+	// that makes newly generated tables any different.
+	static const uint32_t Version = 1;
+
+	// cache directory size budget (bytes).
+	static const qint64 MaxBytes = (64 << 20);
+
+	// load tables, mapped from file, if any (and valid).
+	static synthv1_wave_tables *load ( const synthv1_wave_key& key )
+	{
+		QFile *file = new QFile(path(key));
+		if (!file->open(QIODevice::ReadOnly)) {
+			delete file;
+			return nullptr;
+		}
+
+		const qint64 nbytes = file->size();
+		const uchar *data = (nbytes > qint64(sizeof(Header))
+			? file->map(0, nbytes) : nullptr);
+		if (data == nullptr) {
+			delete file;
+			return nullptr;
+		}
+
+		const Header *header = reinterpret_cast<const Header *> (data);
+		const uint32_t nsize = key.nsize + 4;
+		const uint32_t ntables = (header->parts ? key.ntabs + 1 : 1);
+
+		if (::memcmp(header->magic, Magic, sizeof(header->magic))
+			|| header->version != Version
+			|| header->nsize != key.nsize
+			|| header->nover != key.nover
+			|| header->ntabs != key.ntabs
+			|| header->shape != uint16_t(key.shape)
+			|| header->width != key.width
+			|| header->bandl != (key.bandl ? 1 : 0)
+			|| header->ntables != ntables
+			|| nbytes != qint64(sizeof(Header)
+				+ ntables * nsize * sizeof(float))) {
+			delete file;
+			return nullptr;
+		}
+
+		// touch, as recently used.
+		file->setFileTime(QDateTime::currentDateTime(),
+			QFileDevice::FileModificationTime);
+
+		float *frames = reinterpret_cast<float *> (
+			const_cast<uchar *> (data) + sizeof(Header));
+
+		return new synthv1_wave_tables(key,
+			header->parts, header->phase0, file, frames);
+	}
+
+	// save newly generated tables to file.
+	static void save ( const synthv1_wave_tables *wtabs )
+	{
+		const synthv1_wave_key& key = wtabs->key();
+
+		const QString& sPath = path(key);
+		if (sPath.isEmpty() || !QDir().mkpath(dir()))
+			return;
+
+		const uint32_t nsize = key.nsize + 4;
+		const uint32_t ntables = (wtabs->parts() ? key.ntabs + 1 : 1);
+
+		Header header;
+		::memset(&header, 0, sizeof(header));
+		::memcpy(header.magic, Magic, sizeof(header.magic));
+		header.version = Version;
+		header.nsize   = key.nsize;
+		header.nover   = key.nover;
+		header.ntabs   = key.ntabs;
+		header.shape   = uint16_t(key.shape);
+		header.bandl   = (key.bandl ? 1 : 0);
+		header.parts   = (wtabs->parts() ? 1 : 0);
+		header.width   = key.width;
+		header.phase0  = wtabs->phase0();
+		header.ntables = ntables;
+
+		// written aside, then renamed in one go.
+		QSaveFile file(sPath);
+		if (!file.open(QIODevice::WriteOnly))
+			return;
+
+		file.write(reinterpret_cast<const char *> (&header), sizeof(header));
+
+		float **tables = wtabs->tables();
+		file.write(reinterpret_cast<const char *> (tables[key.ntabs]),
+			nsize * sizeof(float));
+		for (uint32_t itab = 0; itab + 1 < ntables; ++itab) {
+			file.write(reinterpret_cast<const char *> (tables[itab]),
+				nsize * sizeof(float));
+		}
+
+		file.commit();
+	}
+
+	// keep the cache directory under budget, least recently used first.
+	static void purge ()
+	{
+		const QString& sDir = dir();
+		if (sDir.isEmpty())
+			return;
+
+		const QFileInfoList& list = QDir(sDir).entryInfoList(
+			QStringList() << "*.wave", QDir::Files, QDir::Time);
+
+		qint64 nbytes = 0;
+		for (const QFileInfo& info : list) {
+			nbytes += info.size();
+			if (nbytes > MaxBytes)
+				QFile::remove(info.absoluteFilePath());
+		}
+	}
+
+protected:
+
+	// file header.
+	struct Header
+	{
+		char     magic[8];
+		uint32_t version;
+		uint32_t nsize;
+		uint16_t nover;
+		uint16_t ntabs;
+		uint16_t shape;
+		uint8_t  bandl;
+		uint8_t  parts;
+		float    width;
+		float    phase0;
+		uint32_t ntables;
+		uint32_t reserved;
+	};
+
+	static constexpr const char *Magic = "synthv1w";
+
+	// cache directory.
+	static QString dir ()
+	{
+		const QString& sCacheDir = QStandardPaths::writableLocation(
+			QStandardPaths::GenericCacheLocation);
+		if (sCacheDir.isEmpty())
+			return QString();
+
+		return QDir(sCacheDir).filePath(PROJECT_NAME "/waves");
+	}
+
+	// file path (by key).
+	static QString path ( const synthv1_wave_key& key )
+	{
+		const QString& sDir = dir();
+		if (sDir.isEmpty())
+			return QString();
+
+		union { float f; uint32_t i; } u;
+		u.f = key.width;
+
+		return QDir(sDir).filePath(
+			QString("%1-%2-%3-%4-%5-%6.wave")
+				.arg(key.shape).arg(u.i, 8, 16, QChar('0'))
+				.arg(key.bandl ? 1 : 0).arg(key.nsize)
+				.arg(key.nover).arg(key.ntabs));
+	}
+};
+
+#endif	// CONFIG_WAVE_CACHE
+
+
+//-------------------------------------------------------------------------
+// synthv1_wave_cache - process-wide wave tables cache.
+//
+// wave tables are read-only once generated, so all waves (of any engine
+// instance) with the very same settings share one set; unreferenced sets
+// linger for a while (they may well be asked for again) before being
+// freed for good.
+//
+// newly generated sets only get saved to disk once settled, ie. after
+// being in use for a while (eg. preset or initial loads), never the ones
+// just passing by (eg. width automation); saving is batched, at most
+// once in a while, off the audio thread, and once more at the very end.
+
+#include <QElapsedTimer>
+
+
+class synthv1_wave_cache
+{
+public:
+
+	// ctor.
+	synthv1_wave_cache() : m_flushed(0) { m_clock.start(); }
+
+	// dtor.
+	~synthv1_wave_cache()
+	{
+		qDeleteAll(m_tables);
+		m_tables.clear();
+		m_unused.clear();
+	}
+
+	// lookup and reference existing tables, if any.
+	synthv1_wave_tables *acquire ( const synthv1_wave_key& key )
+	{
+		QMutexLocker locker(&m_mutex);
+
+		synthv1_wave_tables *wtabs = m_tables.value(key, nullptr);
+		if (wtabs)
+			addRef(wtabs);
+
+		return wtabs;
+	}
+
+	// add newly generated tables (unless someone else got there first).
+	synthv1_wave_tables *insert ( synthv1_wave_tables *wtabs )
+	{
+		QMutexLocker locker(&m_mutex);
+
+		synthv1_wave_tables *wtabs2 = m_tables.value(wtabs->key(), nullptr);
+		if (wtabs2) {
+			addRef(wtabs2);
+			delete wtabs;
+			return wtabs2;
+		}
+
+		wtabs->setSince(m_clock.elapsed());
+		m_tables.insert(wtabs->key(), wtabs);
+		return wtabs;
+	}
+
+	// unreference tables; purge the oldest unused ones.
+	void release ( synthv1_wave_tables *wtabs )
+	{
+		QMutexLocker locker(&m_mutex);
+
+		if (wtabs->release() > 0)
+			return;
+
+		if (isSettled(wtabs, m_clock.elapsed()))
+			wtabs->setSettled(true);
+
+		m_unused.append(wtabs);
+
+		while (m_unused.count() > MaxUnused) {
+			synthv1_wave_tables *wtabs2 = m_unused.takeFirst();
+			m_tables.remove(wtabs2->key());
+			delete wtabs2;
+		}
+	}
+
+#ifdef CONFIG_WAVE_CACHE
+	// save settled, yet unsaved, tables to disk (batched);
+	// at most once in a while, unless forced to.
+	void flush ( bool force = false )
+	{
+		QList<synthv1_wave_tables *> list;
+
+		{
+			QMutexLocker locker(&m_mutex);
+			const qint64 now = m_clock.elapsed();
+			if (!force && now - m_flushed < FlushMsecs)
+				return;
+			m_flushed = now;
+			QHashIterator<synthv1_wave_key, synthv1_wave_tables *> iter(m_tables);
+			while (iter.hasNext()) {
+				synthv1_wave_tables *wtabs = iter.next().value();
+				if (wtabs->saved() || !wtabs->parts())
+					continue;
+				if (wtabs->settled() || (wtabs->refcount() > 0
+					&& isSettled(wtabs, now))) {
+					wtabs->setSaved(true);
+					addRef(wtabs);
+					list.append(wtabs);
+				}
+			}
+		}
+
+		if (list.isEmpty())
+			return;
+
+		QListIterator<synthv1_wave_tables *> iter(list);
+		while (iter.hasNext()) {
+			synthv1_wave_tables *wtabs = iter.next();
+			synthv1_wave_file::save(wtabs);
+			release(wtabs);
+		}
+
+		synthv1_wave_file::purge();
+	}
+#endif
+
+private:
+
+	// reference tables (under lock).
+	void addRef ( synthv1_wave_tables *wtabs )
+	{
+		if (wtabs->addRef() == 1) {
+			m_unused.removeAll(wtabs);
+			wtabs->setSince(m_clock.elapsed());
+		}
+	}
+
+	// whether tables were in use long enough (under lock).
+	static bool isSettled ( synthv1_wave_tables *wtabs, qint64 now )
+		{ return (now - wtabs->since() >= SettleMsecs); }
+
+	// max. number of unreferenced sets kept around.
+	static const int MaxUnused = 16;
+
+	// min. time in use before saving, and between saves (msecs).
+	static const qint64 SettleMsecs = 5000;
+	static const qint64 FlushMsecs  = 5000;
+
+	// instance variables.
+	QMutex m_mutex;
+
+	QElapsedTimer m_clock;
+	qint64 m_flushed;
+
+	QHash<synthv1_wave_key, synthv1_wave_tables *> m_tables;
+	QList<synthv1_wave_tables *> m_unused;
+};
+
+
+static synthv1_wave_cache *g_wave_cache = nullptr;
+
+static uint32_t g_wave_cache_refcount = 0;
+
+
+// requested shape, width, band-limiting, morphing and analytic mode,
+// packed in one word.
+static inline uint64_t synthv1_wave_reset_key (
+	synthv1_wave::Shape shape, float width, bool bandl,
+	bool wmorph = false, bool blep = false )
+{
+	union { float f; uint32_t i; } u;
+	u.f = width;
+
+	return (uint64_t(u.i) << 32) | (blep ? 0x20 : 0) | (wmorph ? 0x10 : 0)
+		| (uint64_t(shape) << 1) | (bandl ? 1 : 0);
+}
+
+
+//-------------------------------------------------------------------------
+// synthv1_wave_bank - wave tables bank (one set per precomputed width).
+//
+// a plain wave gets a bank of just one set, the one at its very width;
+// width morphing ones get a set on every evenly spaced width step, from
+// zero to full width, each one shared through the cache as usual;
+// analytic (PolyBLEP) ones get no sets at all, just the shape.
+
+class synthv1_wave_bank
+{
+public:
+
+	// number of width steps (morphing banks).
+	static const uint16_t MorphSteps = 16;
+
+	// ctor.
+	synthv1_wave_bank ( uint16_t nsets, int blep = -1 )
+		: m_nsets(nsets), m_parts(false), m_blep(blep)
+	{
+		m_sets = new synthv1_wave_tables * [m_nsets];
+		for (uint16_t iset = 0; iset < m_nsets; ++iset)
+			m_sets[iset] = nullptr;
+	}
+
+	// dtor.
+	~synthv1_wave_bank ()
+	{
+		for (uint16_t iset = 0; iset < m_nsets; ++iset) {
+			if (m_sets[iset])
+				g_wave_cache->release(m_sets[iset]);
+		}
+		delete [] m_sets;
+	}
+
+	// accessors.
+	void setTables ( uint16_t iset, synthv1_wave_tables *wtabs )
+	{
+		m_sets[iset] = wtabs;
+		if (wtabs->parts())
+			m_parts = true;
+	}
+
+	synthv1_wave_tables *tables ( uint16_t iset ) const
+		{ return m_sets[iset]; }
+	uint16_t count() const
+		{ return m_nsets; }
+	bool parts() const
+		{ return m_parts; }
+	int blep() const
+		{ return m_blep; }
+
+private:
+
+	uint16_t              m_nsets;
+	bool                  m_parts;
+	int                   m_blep;
+	synthv1_wave_tables **m_sets;
+};
+
+
+//-------------------------------------------------------------------------
+// synthv1_wave_spectrum - harmonic spectrum, rendered by inverse FFT.
+//
+
+#include <complex>
+
+
+class synthv1_wave_spectrum
+{
+public:
+
+	// ctor.
+	synthv1_wave_spectrum ( uint32_t nsize )
+		: m_nsize(nsize), m_nparts(0),
+			m_bins(new std::complex<double> [nsize]) {}
+
+	// dtor.
+	~synthv1_wave_spectrum ()
+		{ delete [] m_bins; }
+
+	// add a harmonic (0 < k < nsize/2), as in:
+	// a.cos(2pi.k.p/nsize) + b.sin(2pi.k.p/nsize)
+	void add ( uint32_t k, double a, double b )
+	{
+		m_bins[k] += std::complex<double>(a, -b);
+		if (m_nparts < k)
+			m_nparts = k;
+	}
+
+	// render into table frames; nover passes of one-pole smoothing
+	// (y[n] = 0.5 * (x[n] + y[n - 1])) are applied in place, as the
+	// filter frequency response, right on the spectrum.
+	void render ( float *frames, uint16_t nover )
+	{
+		if (nover > 0) {
+			for (uint32_t k = 1; k <= m_nparts; ++k) {
+				const double w = 2.0 * M_PI * double(k) / double(m_nsize);
+				const std::complex<double> h
+					= 0.5 / (1.0 - 0.5 * std::polar(1.0, -w));
+				m_bins[k] *= std::pow(h, int(nover));
+			}
+		}
+
+		if (m_nsize & (m_nsize - 1)) {
+			// not a power of two: plain old additive synthesis...
+			for (uint32_t i = 0; i < m_nsize; ++i) {
+				double sum = 0.0;
+				for (uint32_t k = 1; k <= m_nparts; ++k) {
+					const double w = 2.0 * M_PI * double(k) / double(m_nsize);
+					sum += std::real(m_bins[k] * std::polar(1.0, w * double(i)));
+				}
+				frames[i] = float(sum);
+			}
+		} else {
+			ifft();
+			for (uint32_t i = 0; i < m_nsize; ++i)
+				frames[i] = float(std::real(m_bins[i]));
+		}
+	}
+
+protected:
+
+	// in-place radix-2 inverse complex FFT (unscaled); all bins but
+	// the lowest m (power of 2) are zero, so the first log2(n/m) stages
+	// just copy each (bit-reversed) input bin over its whole block.
+	void ifft ()
+	{
+		const uint32_t n = m_nsize;
+
+		uint32_t m = 2;
+		while (m <= m_nparts && m < n)
+			m <<= 1;
+
+		const uint32_t l = n / m;
+
+		for (uint32_t i = 1, j = 0; i < m; ++i) {
+			uint32_t bit = (m >> 1);
+			for ( ; j & bit; bit >>= 1)
+				j ^= bit;
+			j ^= bit;
+			if (i < j)
+				std::swap(m_bins[i], m_bins[j]);
+		}
+
+		for (uint32_t j = m; j-- > 0;) {
+			const std::complex<double> v = m_bins[j];
+			for (uint32_t i = j * l; i < (j + 1) * l; ++i)
+				m_bins[i] = v;
+		}
+
+		double *x = reinterpret_cast<double *> (m_bins);
+
+		// (plain real arithmetic, as complex products may end up
+		// in a slow library call, checking for nan/inf operands)
+		for (uint32_t len = (l << 1); len <= n; len <<= 1) {
+			const uint32_t len2 = (len >> 1);
+			const double a = 2.0 * M_PI / double(len);
+			const double wr = ::cos(a);
+			const double wi = ::sin(a);
+			double ur = 1.0, ui = 0.0;
+			for (uint32_t k = 0; k < len2; ++k) {
+				for (uint32_t i = k; i < n; i += len) {
+					double *x1 = x + 2 * i;
+					double *x2 = x1 + 2 * len2;
+					const double vr = x2[0] * ur - x2[1] * ui;
+					const double vi = x2[0] * ui + x2[1] * ur;
+					x2[0] = x1[0] - vr;
+					x2[1] = x1[1] - vi;
+					x1[0] += vr;
+					x1[1] += vi;
+				}
+				const double tr = ur * wr - ui * wi;
+				ui = ur * wi + ui * wr;
+				ur = tr;
+			}
+		}
+	}
+
+private:
+
+	uint32_t m_nsize;
+	uint32_t m_nparts;
+
+	std::complex<double> *m_bins;
+};
+
+
 //-------------------------------------------------------------------------
 // synthv1_wave - smoothed (integrating oversampled) wave table.
 //
@@ -59,44 +769,88 @@ private:
 synthv1_wave::synthv1_wave ( uint32_t nsize, uint16_t nover, uint16_t ntabs )
 	: m_nsize(nsize), m_nover(nover), m_ntabs(ntabs),
 		m_shape(Saw), m_width(1.0f), m_bandl(false),
-		m_srate(44100.0f), m_phase0(0.0f), m_srand(0),
-		m_min_freq(0.0f), m_max_freq(0.0f), m_sched(nullptr)
+		m_srate(44100.0f), m_tables(nullptr), m_phase0(0.0f),
+		m_tables2(nullptr), m_xmorph(0.0f), m_srand(0),
+		m_min_freq(0.0f), m_max_freq(0.0f), m_wmorph(false),
+		m_wmorph_test(false), m_blep(-1), m_blep_test(false),
+		m_reset_key(0), m_wbank(nullptr),
+		m_wbank_next(nullptr), m_wbank_prev(nullptr),
+		m_wtabs(nullptr), m_sched(nullptr)
 {
-	const uint16_t ntabs1 = m_ntabs + 1;
+	if (++g_wave_cache_refcount == 1 && g_wave_cache == nullptr)
+		g_wave_cache = new synthv1_wave_cache();
 
-	m_tables = new float * [ntabs1];
-	for (uint16_t itab = 0; itab < ntabs1; ++itab)
-		m_tables[itab] = new float [m_nsize + 4];
+	m_reset_key.store(synthv1_wave_reset_key(m_shape, m_width, m_bandl));
 
-	if (m_ntabs > 0)
+	if (m_ntabs > 0) {
 		m_sched = new synthv1_wave_sched(this);
-
-	reset_sync();
+		reset_swap(reset_bank());
+	} else {
+		// own tables, never shared, allocated once
+		// and then regenerated in place (eg. LFO).
+		synthv1_wave_key key;
+		key.nsize = m_nsize;
+		key.nover = m_nover;
+		key.ntabs = m_ntabs;
+		key.shape = int(m_shape);
+		key.width = m_width;
+		key.bandl = false;
+		m_wtabs = new synthv1_wave_tables(key, false);
+		reset_sync();
+	}
 }
 
 
 // dtor.
 synthv1_wave::~synthv1_wave (void)
 {
-	if (m_sched)
+	if (m_sched) {
+		m_sched->sync_cancel();
 		delete m_sched;
+	}
+
+	synthv1_wave_bank *wbank_next = m_wbank_next.exchange(nullptr);
+	if (wbank_next)
+		delete wbank_next;
+
+	reset_reclaim();
 
-	const uint16_t ntabs1 = m_ntabs + 1;
+	if (m_wbank)
+		delete m_wbank;
 
-	for (uint16_t itab = 0; itab < ntabs1; ++itab)
-		delete [] m_tables[itab];
+	if (m_wtabs)
+		delete m_wtabs;
 
-	delete [] m_tables;
+	if (--g_wave_cache_refcount == 0) {
+		if (g_wave_cache) {
+		#ifdef CONFIG_WAVE_CACHE
+			g_wave_cache->flush(true);
+		#endif
+			delete g_wave_cache;
+			g_wave_cache = nullptr;
+		}
+	}
 }
 
 
 // init.
-void synthv1_wave::reset ( Shape shape, float width, bool bandl )
+void synthv1_wave::reset ( Shape shape, float width, bool bandl, bool blep )
 {
 	m_shape = shape;
 	m_width = width;
 	m_bandl = bandl;
 
+	m_wmorph_test = isWidthMorph();
+	m_blep_test = blep;
+
+	// analytic mode takes over, on pulse and saw shapes only.
+	const bool blep2 = (blep && m_ntabs > 0 && shape <= Saw);
+
+	// the whole request, for the sched thread to pick in one go.
+	m_reset_key.store(synthv1_wave_reset_key(shape, width, bandl,
+		m_wmorph_test && m_ntabs > 0 && shape <= Sine && !blep2, blep2),
+		std::memory_order_release);
+
 	if (m_sched)
 		m_sched->schedule();
 	else
@@ -106,21 +860,151 @@ void synthv1_wave::reset ( Shape shape, float width, bool bandl )
 
 void synthv1_wave::reset_sync (void)
 {
-	switch (m_shape) {
+	// no separate thread: own tables, regenerated in place
+	// (no allocation, no locking, safe on the audio thread).
+	if (m_wtabs) {
+		reset_inplace();
+		return;
+	}
+
+	// publish, to be swapped in by the audio thread
+	// on its next cycle; the one possibly published
+	// before, but never swapped in, goes right away.
+	synthv1_wave_bank *wbank = reset_bank();
+
+	wbank = m_wbank_next.exchange(wbank, std::memory_order_acq_rel);
+
+	if (wbank)
+		delete wbank;
+
+#ifdef CONFIG_WAVE_CACHE
+	// save settled tables, if due.
+	g_wave_cache->flush();
+#endif
+}
+
+
+// init own tables, in place (no separate thread).
+void synthv1_wave::reset_inplace (void)
+{
+	float **tables = m_wtabs->tables();
+
+	reset_shape(tables, m_shape, m_width, false);
+
+	m_tables  = m_tables2 = tables;
+	m_phase0  = reset_phase0(tables[m_ntabs]);
+	m_xmorph  = 0.0f;
+	m_blep    = -1;
+
+	m_max_freq = (0.5f * m_srate);
+	m_min_freq = m_max_freq;
+}
+
+
+// retired tables reclaim (off the audio thread).
+void synthv1_wave::reset_reclaim (void)
+{
+	synthv1_wave_bank *wbank
+		= m_wbank_prev.exchange(nullptr, std::memory_order_acq_rel);
+	if (wbank)
+		delete wbank;
+}
+
+
+// init tables bank (as requested).
+synthv1_wave_bank *synthv1_wave::reset_bank (void)
+{
+	// requested settings, as one consistent snapshot.
+	const uint64_t reset_key = m_reset_key.load(std::memory_order_acquire);
+	union { uint32_t i; float f; } u;
+	u.i = uint32_t(reset_key >> 32);
+
+	const Shape shape = Shape((reset_key >> 1) & 0x7);
+	const float width = u.f;
+	const bool  bandl = (reset_key & 1);
+	const bool wmorph = (reset_key & 0x10);
+	const bool blep   = (reset_key & 0x20);
+
+	synthv1_wave_bank *wbank;
+
+	if (blep) {
+		wbank = new synthv1_wave_bank(0, int(shape));
+	}
+	else
+	if (wmorph) {
+		const uint16_t nsteps = synthv1_wave_bank::MorphSteps;
+		wbank = new synthv1_wave_bank(nsteps + 1);
+		for (uint16_t iset = 0; iset <= nsteps; ++iset) {
+			const float width2 = float(iset) / float(nsteps);
+			wbank->setTables(iset, reset_tables(shape, width2, bandl));
+		}
+	} else {
+		wbank = new synthv1_wave_bank(1);
+		wbank->setTables(0, reset_tables(shape, width, bandl));
+	}
+
+	return wbank;
+}
+
+
+// init tables (shared or generated).
+synthv1_wave_tables *synthv1_wave::reset_tables (
+	Shape shape, float width, bool bandl )
+{
+	synthv1_wave_key key;
+	key.nsize = m_nsize;
+	key.nover = m_nover;
+	key.ntabs = m_ntabs;
+	key.shape = int(shape);
+	key.width = width;
+	key.bandl = bandl;
+
+	// partial (band-limited) tables in need?
+	const bool parts = (key.bandl && m_ntabs > 0
+		&& (key.shape != Sine || key.width < 1.0f));
+
+	// shared tables, or generate a brand new set...
+	synthv1_wave_tables *wtabs = g_wave_cache->acquire(key);
+#ifdef CONFIG_WAVE_CACHE
+	// or load a previously generated one, from disk
+	// (band-limited only, the only ones ever saved).
+	if (wtabs == nullptr && parts) {
+		wtabs = synthv1_wave_file::load(key);
+		if (wtabs)
+			wtabs = g_wave_cache->insert(wtabs);
+	}
+#endif
+	if (wtabs == nullptr) {
+		wtabs = new synthv1_wave_tables(key, parts);
+		float **tables = wtabs->tables();
+		reset_shape(tables, shape, key.width, parts);
+		wtabs->setPhase0(reset_phase0(tables[m_ntabs]));
+		wtabs = g_wave_cache->insert(wtabs);
+	}
+
+	return wtabs;
+}
+
+
+// init tables (generate, per shape).
+void synthv1_wave::reset_shape (
+	float **tables, Shape shape, float width, bool parts )
+{
+	switch (shape) {
 	case Pulse:
-		reset_pulse();
+		reset_pulse(tables, width, parts);
 		break;
 	case Saw:
-		reset_saw();
+		reset_saw(tables, width, parts);
 		break;
 	case Sine:
-		reset_sine();
+		reset_sine(tables, width, parts);
 		break;
 	case Rand:
-		reset_rand();
+		reset_rand(tables, width, parts);
 		break;
 	case Noise:
-		reset_noise();
+		reset_noise(tables, width, parts);
 		// Fall thru...
 	default:
 		break;
@@ -128,14 +1012,14 @@ void synthv1_wave::reset_sync (void)
 }
 
 
-// init pulse tables.
-void synthv1_wave::reset_pulse (void)
+// init tables bank swap (current).
+void synthv1_wave::reset_swap ( synthv1_wave_bank *wbank )
 {
-	reset_pulse_part(m_ntabs);
+	m_wbank = wbank;
 
-	if (m_bandl) {
-		for (uint16_t itab = 0; itab < m_ntabs; ++itab)
-			reset_pulse_part(itab);
+	reset_morph(m_width);
+
+	if (wbank->parts()) {
 		m_max_freq = (0.25f * m_srate);
 		m_min_freq = m_max_freq / float(1 << m_ntabs);
 	} else {
@@ -145,167 +1029,220 @@ void synthv1_wave::reset_pulse (void)
 }
 
 
+// swap in the published tables (audio thread, between cycles).
+void synthv1_wave::reset_swap_next (void)
+{
+	// previous tables not reclaimed yet? try again next cycle...
+	if (m_wbank_prev.load(std::memory_order_acquire) == nullptr) {
+		synthv1_wave_bank *wbank
+			= m_wbank_next.exchange(nullptr, std::memory_order_acq_rel);
+		if (wbank) {
+			m_wbank_prev.store(m_wbank, std::memory_order_release);
+			reset_swap(wbank);
+		}
+	}
+
+	m_sched->schedule(synthv1_wave_sched::Reclaim);
+}
+
+
+// init width morph (current bank): pick the two sets
+// around the given width and the crossfade in between.
+void synthv1_wave::reset_morph ( float width )
+{
+	m_width = width;
+
+	// analytic, no tables whatsoever.
+	m_blep = m_wbank->blep();
+	if (m_blep >= 0) {
+		m_tables  = m_tables2 = nullptr;
+		m_phase0  = (m_blep == Saw ? 0.5f * width : 0.0f);
+		m_xmorph  = 0.0f;
+		return;
+	}
+
+	const uint16_t nsets = m_wbank->count();
+	if (nsets < 2) {
+		synthv1_wave_tables *wtabs = m_wbank->tables(0);
+		m_tables  = m_tables2 = wtabs->tables();
+		m_phase0  = wtabs->phase0();
+		m_xmorph  = 0.0f;
+		return;
+	}
+
+	float xmorph = width * float(nsets - 1);
+	if (xmorph < 0.0f)
+		xmorph = 0.0f;
+	uint16_t iset = uint16_t(xmorph);
+	if (iset > nsets - 2)
+		iset = nsets - 2;
+	xmorph -= float(iset);
+	if (xmorph > 1.0f)
+		xmorph = 1.0f;
+
+	synthv1_wave_tables *wtabs1 = m_wbank->tables(iset);
+	synthv1_wave_tables *wtabs2 = m_wbank->tables(iset + 1);
+
+	m_tables  = wtabs1->tables();
+	m_tables2 = wtabs2->tables();
+	m_phase0  = (xmorph < 0.5f ? wtabs1 : wtabs2)->phase0();
+	m_xmorph  = xmorph;
+}
+
+
+// init pulse tables.
+void synthv1_wave::reset_pulse ( float **tables, float width, bool parts )
+{
+	reset_pulse_part(tables, width, m_ntabs);
+
+	if (parts) {
+		for (uint16_t itab = 0; itab < m_ntabs; ++itab)
+			reset_pulse_part(tables, width, itab);
+	}
+}
+
+
 // init saw tables.
-void synthv1_wave::reset_saw (void)
+void synthv1_wave::reset_saw ( float **tables, float width, bool parts )
 {
-	reset_saw_part(m_ntabs);
+	reset_saw_part(tables, width, m_ntabs);
 
-	if (m_bandl) {
+	if (parts) {
 		for (uint16_t itab = 0; itab < m_ntabs; ++itab)
-			reset_saw_part(itab);
-		m_max_freq = (0.25f * m_srate);
-		m_min_freq = m_max_freq / float(1 << m_ntabs);
-	} else {
-		m_max_freq = (0.5f * m_srate);
-		m_min_freq = m_max_freq;
+			reset_saw_part(tables, width, itab);
 	}
 }
 
 
 // init sine tables.
-void synthv1_wave::reset_sine (void)
+void synthv1_wave::reset_sine ( float **tables, float width, bool parts )
 {
-	reset_sine_part(m_ntabs);
+	reset_sine_part(tables, width, m_ntabs);
 
-	if (m_bandl && m_width < 1.0f) {
+	if (parts) {
 		for (uint16_t itab = 0; itab < m_ntabs; ++itab)
-			reset_sine_part(itab);
-		m_max_freq = (0.25f * m_srate);
-		m_min_freq = m_max_freq / float(1 << m_ntabs);
-	} else {
-		m_max_freq = (0.5f * m_srate);
-		m_min_freq = m_max_freq;
+			reset_sine_part(tables, width, itab);
 	}
 }
 
 
 // init random tables.
-void synthv1_wave::reset_rand (void)
+void synthv1_wave::reset_rand ( float **tables, float width, bool parts )
 {
-	reset_rand_part(m_ntabs);
+	reset_rand_part(tables, width, m_ntabs);
 
-	if (m_bandl) {
+	if (parts) {
 		for (uint16_t itab = 0; itab < m_ntabs; ++itab)
-			reset_rand_part(itab);
-		m_max_freq = (0.25f * m_srate);
-		m_min_freq = m_max_freq / float(1 << m_ntabs);
-	} else {
-		m_max_freq = (0.5f * m_srate);
-		m_min_freq = m_max_freq;
+			reset_rand_part(tables, width, itab);
 	}
 }
 
 
 // init noise tables.
-void synthv1_wave::reset_noise (void)
+void synthv1_wave::reset_noise ( float **tables, float width, bool parts )
 {
-	reset_noise_part(m_ntabs);
+	reset_noise_part(tables, width, m_ntabs);
 
-	if (m_bandl) {
+	if (parts) {
 		for (uint16_t itab = 0; itab < m_ntabs; ++itab)
-			reset_noise_part(itab);
-		m_max_freq = (0.25f * m_srate);
-		m_min_freq = m_max_freq / float(1 << m_ntabs);
-	} else {
-		m_max_freq = (0.5f * m_srate);
-		m_min_freq = m_max_freq;
+			reset_noise_part(tables, width, itab);
 	}
 }
 
 
 // init pulse partial table.
-void synthv1_wave::reset_pulse_part ( uint16_t itab )
+void synthv1_wave::reset_pulse_part ( float **tables, float width, uint16_t itab )
 {
 	const uint16_t nparts = (itab < m_ntabs ? 1 << itab : 0);
 
 	const float p0 = float(m_nsize);
-	const float w2 = p0 * m_width * 0.5f + 0.001f;
+	const float w2 = p0 * width * 0.5f + 0.001f;
 
-	float *frames = m_tables[itab];
+	float *frames = tables[itab];
 
-	for (uint32_t i = 0; i < m_nsize; ++i) {
-		const float p = float(i);
-		if (nparts > 0) {
-			const float gibbs = 0.5f * M_PI / float(nparts);
-			float sum = 0.0f;
-			for (uint32_t n = 0; n < nparts; ++n) {
-				const float gn = ::cosf(gibbs * float(n));
-				const float dn = float(n + 1) * M_PI;
-				const float wn = 2.0f * dn;
-				const float g2 = gn * gn / dn;
-				sum += g2 * ::sinf(wn * (w2 - p) / p0);
-				sum += g2 * ::sinf(wn * (p - p0) / p0);
-			}
-			frames[i] = 2.0f * sum;
-		} else {
+	if (nparts > 0) {
+		synthv1_wave_spectrum spectrum(m_nsize);
+		const double gibbs = 0.5 * M_PI / double(nparts);
+		for (uint32_t n = 0; n < nparts; ++n) {
+			const double gn = ::cos(gibbs * double(n));
+			const double dn = double(n + 1) * M_PI;
+			const double g2 = 2.0 * gn * gn / dn;
+			const double an = 2.0 * dn * double(w2) / double(p0);
+			spectrum.add(n + 1, g2 * ::sin(an), g2 * (1.0 - ::cos(an)));
+		}
+		spectrum.render(frames, m_nover);
+	} else {
+		for (uint32_t i = 0; i < m_nsize; ++i) {
+			const float p = float(i);
 			frames[i] = (p < w2 ? 1.0f : -1.0f);
 		}
+		reset_filter(frames);
 	}
 
-	reset_filter(itab);
-	reset_normalize(itab);
-	reset_interp(itab);
+	reset_normalize(frames);
+	reset_interp(frames);
 }
 
 
 // init saw partial table.
-void synthv1_wave::reset_saw_part ( uint16_t itab )
+void synthv1_wave::reset_saw_part ( float **tables, float width, uint16_t itab )
 {
 	const uint16_t nparts = (itab < m_ntabs ? 1 << itab : 0);
 
 	const float p0 = float(m_nsize);
-	const float w0 = p0 * m_width;
+	const float w0 = p0 * width;
 
-	float *frames = m_tables[itab];
+	float *frames = tables[itab];
 
-	for (uint32_t i = 0; i < m_nsize; ++i) {
-		const float p = float(i);
-		if (nparts > 0) {
-			const float gibbs = 0.5f * M_PI / float(nparts);
-			float sum = 0.0f;
-			float sgn = 2.0f;
-			for (uint32_t n = 0; n < nparts; ++n) {
-				const float gn = ::cosf(gibbs * float(n));
-				const float dn = float(n + 1) * M_PI;
-				const float wn = 2.0f * dn;
-				const float g2 = gn * gn / dn;
-				if (w0 < 1.0f)
-					sum += g2 * ::sinf(wn * p / p0);
-				else
-				if (w0 >= p0) 
-					sum += g2 * ::sinf(wn * (p0 - p) / p0);
-				else {
-					sum -= sgn * g2 * ::cosf(wn * (w0 - p) / p0) / dn;
-					sum += sgn * g2 * ::cosf(wn * (p - p0) / p0) / dn;
-					sgn = -sgn;
-				}
+	if (nparts > 0) {
+		synthv1_wave_spectrum spectrum(m_nsize);
+		const double gibbs = 0.5 * M_PI / double(nparts);
+		double sgn = 2.0;
+		for (uint32_t n = 0; n < nparts; ++n) {
+			const double gn = ::cos(gibbs * double(n));
+			const double dn = double(n + 1) * M_PI;
+			const double g2 = 2.0 * gn * gn / dn;
+			if (w0 < 1.0f)
+				spectrum.add(n + 1, 0.0, +g2);
+			else
+			if (w0 >= p0)
+				spectrum.add(n + 1, 0.0, -g2);
+			else {
+				const double bn = 2.0 * dn * double(w0) / double(p0);
+				const double gk = sgn * g2 / dn;
+				spectrum.add(n + 1, gk * (1.0 - ::cos(bn)), -gk * ::sin(bn));
+				sgn = -sgn;
 			}
-			frames[i] = 2.0f * sum;
 		}
-		else if (p < w0) {
-			frames[i] = 2.0f * p / w0 - 1.0f;
-		} else {
-			frames[i] = 1.0f - 2.0f * (1.0f + (p - w0)) / (p0 - w0);
+		spectrum.render(frames, m_nover);
+	} else {
+		for (uint32_t i = 0; i < m_nsize; ++i) {
+			const float p = float(i);
+			if (p < w0) {
+				frames[i] = 2.0f * p / w0 - 1.0f;
+			} else {
+				frames[i] = 1.0f - 2.0f * (1.0f + (p - w0)) / (p0 - w0);
+			}
 		}
+		reset_filter(frames);
 	}
 
-	reset_filter(itab);
-	reset_normalize(itab);
-	reset_interp(itab);
+	reset_normalize(frames);
+	reset_interp(frames);
 }
 
 
 // init sine partial table.
-void synthv1_wave::reset_sine_part ( uint16_t itab )
+void synthv1_wave::reset_sine_part ( float **tables, float width, uint16_t itab )
 {
-	const float width = (itab >= m_ntabs ? m_width
-		: 1.0f + float(itab) * (m_width - 1.0f) / float(m_ntabs));
+	const float width2 = (itab >= m_ntabs ? width
+		: 1.0f + float(itab) * (width - 1.0f) / float(m_ntabs));
 
 	const float p0 = float(m_nsize);
-	const float w0 = p0 * width;
+	const float w0 = p0 * width2;
 	const float w2 = w0 * 0.5f;
 
-	float *frames = m_tables[itab];
+	float *frames = tables[itab];
 
 	for (uint32_t i = 0; i < m_nsize; ++i) {
 		float p = float(i);
@@ -315,27 +1252,27 @@ void synthv1_wave::reset_sine_part ( uint16_t itab )
 			frames[i] = ::sinf(M_PI * (p + (p0 - w0)) / (p0 - w2));
 	}
 
-	if (width < 1.0f) {
-		reset_filter(itab);
-		reset_normalize(itab);
+	if (width2 < 1.0f) {
+		reset_filter(frames);
+		reset_normalize(frames);
 	}
-	reset_interp(itab);
+	reset_interp(frames);
 }
 
 
 // init random partial table.
-void synthv1_wave::reset_rand_part ( uint16_t itab )
+void synthv1_wave::reset_rand_part ( float **tables, float width, uint16_t itab )
 {
 	const uint16_t nparts = (itab < m_ntabs ? 1 << itab : 0);
 
 	const float p0 = float(m_nsize);
-	const float w0 = p0 * m_width;
+	const float w0 = p0 * width;
 	const uint32_t ihold = (uint32_t(p0 - w0) >> 3) + 1;
 
-	float *frames = m_tables[itab];
+	float *frames = tables[itab];
 
 	if (nparts > 0) {
-		const float *pntabs = m_tables[m_ntabs];
+		const float *pntabs = tables[m_ntabs];
 		const uint32_t nholds = m_nsize / ihold;
 		const uint32_t ntabs2 = m_ntabs << itab;
 		uint32_t npart2 = nparts;
@@ -349,25 +1286,26 @@ void synthv1_wave::reset_rand_part ( uint16_t itab )
 		}
 		const float wk = p0 / float(nhold2);
 		const float w2 = 0.5f * wk;
-		const float gibbs = 0.5f * M_PI / float(npart2);
-		for (uint32_t i = 0; i < m_nsize; ++i) {
-			const float p = float(i);
-			float sum = 0.0f;
-			for (uint32_t n = 0; n < npart2; ++n) {
-				const float gn = ::cosf(gibbs * float(n));
-				const float dn = float(n + 1) * M_PI;
-				const float wn = 2.0f * dn;
-				const float g2 = gn * gn / dn;
-				float pk = 0.0f;
-				for (uint32_t k = 0; k < nhold2; ++k) {
-					const float gk = g2 * pntabs[uint32_t(pk + w2)];
-					sum += gk * ::sinf(wn * (wk - p + pk) / p0);
-					sum += gk * ::sinf(wn * (p - p0 - pk) / p0);
-					pk  += wk;
-				}
+		synthv1_wave_spectrum spectrum(m_nsize);
+		const double gibbs = 0.5 * M_PI / double(npart2);
+		for (uint32_t n = 0; n < npart2; ++n) {
+			const double gn = ::cos(gibbs * double(n));
+			const double dn = double(n + 1) * M_PI;
+			const double wn = 2.0 * dn / double(p0);
+			const double g2 = 2.0 * gn * gn / dn;
+			double an = 0.0, bn = 0.0;
+			float pk = 0.0f;
+			for (uint32_t k = 0; k < nhold2; ++k) {
+				const double gk = g2 * pntabs[uint32_t(pk + w2)];
+				const double a1 = wn * double(wk + pk);
+				const double b1 = wn * double(pk);
+				an += gk * (::sin(a1) - ::sin(b1));
+				bn += gk * (::cos(b1) - ::cos(a1));
+				pk += wk;
 			}
-			frames[i] = 2.0f * sum;
+			spectrum.add(n + 1, an, bn);
 		}
+		spectrum.render(frames, m_nover);
 	} else {
 		m_srand = uint32_t(w0);
 		float phold = 0.0f;
@@ -376,39 +1314,37 @@ void synthv1_wave::reset_rand_part ( uint16_t itab )
 				phold = pseudo_randf();
 			frames[i] = phold;
 		}
+		reset_filter(frames);
 	}
 
-	reset_filter(itab);
-	reset_normalize(itab);
-	reset_interp(itab);
+	reset_normalize(frames);
+	reset_interp(frames);
 }
 
 
 // init random partial table.
-void synthv1_wave::reset_noise_part ( uint16_t itab )
+void synthv1_wave::reset_noise_part ( float **tables, float width, uint16_t itab )
 {
 	if (itab == m_ntabs) {
 		const float p0 = float(m_nsize);
-		const float w0 = p0 * m_width;
+		const float w0 = p0 * width;
 		m_srand = uint32_t(w0) ^ 0x9631; // magic!
 	}
 
-	float *frames = m_tables[itab];
+	float *frames = tables[itab];
 
 	for (uint32_t i = 0; i < m_nsize; ++i)
 		frames[i] = pseudo_randf();
 
-//	reset_filter(itab);
-//	reset_normalize(itab);
-	reset_interp(itab);
+//	reset_filter(frames);
+//	reset_normalize(frames);
+	reset_interp(frames);
 }
 
 
 // post-processors.
-void synthv1_wave::reset_filter ( uint16_t itab )
+void synthv1_wave::reset_filter ( float *frames )
 {
-	float *frames = m_tables[itab];
-
 	uint32_t i, k = 0;
 
 	for (i = 1; i < m_nsize; ++i) {
@@ -431,10 +1367,8 @@ void synthv1_wave::reset_filter ( uint16_t itab )
 }
 
 
-void synthv1_wave::reset_normalize ( uint16_t itab )
+void synthv1_wave::reset_normalize ( float *frames )
 {
-	float *frames = m_tables[itab];
-	
 	uint32_t i;
 
 	float pmax = 0.0f;
@@ -473,25 +1407,26 @@ void synthv1_wave::reset_normalize ( uint16_t itab )
 }
 
 
-void synthv1_wave::reset_interp ( uint16_t itab )
+void synthv1_wave::reset_interp ( float *frames )
 {
-	float *frames = m_tables[itab];
+	for (uint32_t i = m_nsize; i < m_nsize + 4; ++i)
+		frames[i] = frames[i - m_nsize];
+}
 
-	uint32_t i;
 
-	for (i = m_nsize; i < m_nsize + 4; ++i)
-		frames[i] = frames[i - m_nsize];
+// phase-zero (last upward zero-crossing).
+float synthv1_wave::reset_phase0 ( const float *frames ) const
+{
+	uint32_t k = 0;
 
-	if (itab == m_ntabs) {
-		uint32_t k = 0;
-		for (i = 1; i < m_nsize; ++i) {
-			const float p1 = frames[i - 1];
-			const float p2 = frames[i];
-			if (p1 < 0.0f && p2 >= 0.0f)
-				k = i;
-		}
-		m_phase0 = float(k) / float(m_nsize);
+	for (uint32_t i = 1; i < m_nsize; ++i) {
+		const float p1 = frames[i - 1];
+		const float p2 = frames[i];
+		if (p1 < 0.0f && p2 >= 0.0f)
+			k = i;
 	}
+
+	return float(k) / float(m_nsize);
 }
 
 
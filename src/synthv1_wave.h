@@ -1,7 +1,7 @@
 // synthv1_wave.h
 //
 /****************************************************************************
-   Copyright (C) 2012-2023, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -24,9 +24,13 @@
 
 #include <cstdint>
 
+#include <atomic>
+
 
 // forward decls.
 class synthv1_wave_sched;
+class synthv1_wave_tables;
+class synthv1_wave_bank;
 
 
 //-------------------------------------------------------------------------
@@ -68,17 +72,45 @@ public:
 	float phase0() const
 		{ return m_phase0; }
 
+	// width morphing: pulse, saw and sine shapes get a bank of tables,
+	// precomputed at evenly spaced widths, to crossfade in between
+	// instead of having new ones generated on every width change.
+	void setWidthMorph(bool wmorph)
+		{ m_wmorph.store(wmorph, std::memory_order_release); }
+	bool isWidthMorph() const
+		{ return m_wmorph.load(std::memory_order_acquire); }
+
+	// analytic (PolyBLEP) mode: pulse and saw shapes get no tables
+	// at all, but are evaluated right away, one pass per sample,
+	// with polynomial band-limited step (and ramp) corrections.
+	bool isPolyBlep() const
+		{ return (m_blep >= 0); }
+
 	// init.
-	void reset(Shape shape, float width, bool bandl = false);
+	void reset(Shape shape, float width, bool bandl = false, bool blep = false);
 	// init.sync.
 	void reset_sync();
+	// retired tables reclaim.
+	void reset_reclaim();
 
-	// init.test
-	void reset_test(Shape shape, float width, bool bandl = false)
+	// init.test (audio thread, once per cycle)
+	void reset_test(Shape shape, float width, bool bandl = false, bool blep = false)
 	{
-		if (shape != m_shape || width != m_width
-			|| (m_ntabs > 0 && bandl != m_bandl))
-			reset(shape, width, bandl);
+		// swap in newly generated tables, if any.
+		if (m_wbank_next.load(std::memory_order_acquire))
+			reset_swap_next();
+
+		if (shape != m_shape || isWidthMorph() != m_wmorph_test
+			|| blep != m_blep_test || (m_ntabs > 0 && bandl != m_bandl))
+			reset(shape, width, bandl, blep);
+		else
+		if (width != m_width) {
+			if (m_ntabs > 0 && ((m_blep_test && shape <= Saw)
+				|| (m_wmorph_test && shape <= Sine)))
+				reset_morph(width);
+			else
+				reset(shape, width, bandl, blep);
+		}
 	}
 
 	// phasor.
@@ -116,6 +148,9 @@ public:
 	// iterate.
 	float sample(Phase& phase, float freq) const
 	{
+		if (m_blep >= 0)
+			return sample_blep(phase, freq);
+
 		const float index = phase.phase * float(m_nsize);
 		const uint32_t i = uint32_t(index);
 		const float alpha = index - float(i);
@@ -136,13 +171,67 @@ public:
 		}
 	}
 
+	// iterate, fetching the raw frames to interpolate instead;
+	// NFRAMES (1, 2 or 4) frames from the current table, as many
+	// from the next one (or the same, on the last), both at x[],
+	// returns the fractional index.
+	template <uint32_t NFRAMES = 2>
+	float sample_frames(Phase& phase, float freq, float *x) const
+	{
+		// analytic: the very same value on all frames.
+		if (m_blep >= 0) {
+			const float x0 = sample_blep(phase, freq);
+			for (uint32_t k = 0; k < NFRAMES + NFRAMES; ++k)
+				x[k] = x0;
+			return 0.0f;
+		}
+
+		const float index = phase.phase * float(m_nsize);
+		const uint32_t i = uint32_t(index);
+		const float alpha = index - float(i);
+
+		phase.phase += freq / m_srate;
+		if (phase.phase >= 1.0f) {
+			phase.phase -= 1.0f;
+			if (phase.slave)
+				phase.slave->phase = phase.slave_phase0;
+		}
+
+		const float *frames0 = m_tables[phase.itab];
+		const float *frames1 = (phase.itab < m_ntabs
+			? m_tables[phase.itab + 1] : frames0);
+
+		for (uint32_t k = 0; k < NFRAMES; ++k) {
+			x[k] = frames0[i + k];
+			x[k + NFRAMES] = frames1[i + k];
+		}
+
+		if (m_xmorph > 0.0f) {
+			const float *frames2 = m_tables2[phase.itab];
+			const float *frames3 = (phase.itab < m_ntabs
+				? m_tables2[phase.itab + 1] : frames2);
+			for (uint32_t k = 0; k < NFRAMES; ++k) {
+				x[k] += m_xmorph * (frames2[i + k] - x[k]);
+				x[k + NFRAMES] += m_xmorph * (frames3[i + k] - x[k + NFRAMES]);
+			}
+		}
+
+		return alpha;
+	}
+
 	// interpolate.
 	float interp(uint32_t i, uint16_t itab, float alpha) const
 	{
 		float *frames = m_tables[itab];
 
-		const float x0 = frames[i];
-		const float x1 = frames[i + 1];
+		float x0 = frames[i];
+		float x1 = frames[i + 1];
+
+		if (m_xmorph > 0.0f) {
+			float *frames2 = m_tables2[itab];
+			x0 += m_xmorph * (frames2[i] - x0);
+			x1 += m_xmorph * (frames2[i + 1] - x1);
+		}
 #if 0	// cubic interp.
 		const float x2 = frames[i + 2];
 		const float x3 = frames[i + 3];
@@ -166,6 +255,9 @@ public:
 		if (phase >= 1.0f)
 			phase -= 1.0f;
 
+		if (m_blep >= 0)
+			return value_blep(phase, 0.0f);
+
 		return m_tables[m_ntabs][uint32_t(phase * float(m_nsize))];
 	}
 
@@ -187,6 +279,89 @@ public:
 
 protected:
 
+	// iterate (analytic).
+	float sample_blep(Phase& phase, float freq) const
+	{
+		const float t = phase.phase;
+		const float dt = freq / m_srate;
+
+		phase.phase += dt;
+		if (phase.phase >= 1.0f) {
+			phase.phase -= 1.0f;
+			if (phase.slave)
+				phase.slave->phase = phase.slave_phase0;
+		}
+
+		return value_blep(t, dt);
+	}
+
+	// analytic pulse and saw (PolyBLEP/PolyBLAMP corrected),
+	// at phase t and phase increment dt (per sample); scaled
+	// as their normalized (zero-mean, unit-peak) table peers.
+	float value_blep(float t, float dt) const
+	{
+		if (dt > 0.5f)
+			dt = 0.5f;
+
+		const float w = m_width;
+
+		if (m_blep == Pulse) {
+			const float d = 0.5f * w;
+			float t2 = t - d;
+			if (t2 < 0.0f)
+				t2 += 1.0f;
+			const float y = (t < d ? 1.0f : -1.0f)
+				+ 2.0f * (poly_blep(t, dt) - poly_blep(t2, dt));
+			return (y + 1.0f - 2.0f * d) / (2.0f - 2.0f * d);
+		}
+
+		// saw: ramp up, down or anything (triangle) in between.
+		if (w >= 1.0f - dt)
+			return 2.0f * (t - poly_blep(t, dt)) - 1.0f;
+		if (w <= dt)
+			return 1.0f - 2.0f * (t - poly_blep(t, dt));
+
+		float t2 = t - w;
+		if (t2 < 0.0f)
+			t2 += 1.0f;
+		const float y = (t < w
+			? 2.0f * t / w - 1.0f
+			: 1.0f - 2.0f * t2 / (1.0f - w));
+		const float ds = 2.0f / w + 2.0f / (1.0f - w);
+		return y + ds * dt * (poly_blamp(t, dt) - poly_blamp(t2, dt));
+	}
+
+	// band-limited step residual (unit step at t = 0).
+	static inline float poly_blep ( float t, float dt )
+	{
+		if (t < dt) {
+			const float x = 1.0f - t / dt;
+			return -0.5f * x * x;
+		}
+		else
+		if (t > 1.0f - dt) {
+			const float x = 1.0f + (t - 1.0f) / dt;
+			return 0.5f * x * x;
+		}
+		return 0.0f;
+	}
+
+	// band-limited ramp residual (unit slope change at t = 0),
+	// in phase units (times dt).
+	static inline float poly_blamp ( float t, float dt )
+	{
+		if (t < dt) {
+			const float x = 1.0f - t / dt;
+			return x * x * x / 6.0f;
+		}
+		else
+		if (t > 1.0f - dt) {
+			const float x = 1.0f + (t - 1.0f) / dt;
+			return x * x * x / 6.0f;
+		}
+		return 0.0f;
+	}
+
 	// fast log2f approximation.
 	static inline float fast_log2f ( float x )
 	{
@@ -195,35 +370,55 @@ protected:
 		return (u.i * 1.192092896e-7f) - 126.943612f;
 	}
 
+	// init tables bank (as requested).
+	synthv1_wave_bank *reset_bank();
+	// init tables (shared or generated).
+	synthv1_wave_tables *reset_tables(Shape shape, float width, bool bandl);
+	// init tables (generate, per shape).
+	void reset_shape(float **tables, Shape shape, float width, bool parts);
+
+	// init own tables, in place (no separate thread).
+	void reset_inplace();
+
+	// init tables bank swap (current).
+	void reset_swap(synthv1_wave_bank *wbank);
+	void reset_swap_next();
+
+	// init width morph (current bank).
+	void reset_morph(float width);
+
 	// init pulse tables.
-	void reset_pulse();
+	void reset_pulse(float **tables, float width, bool parts);
 	// init pulse partial table.
-	void reset_pulse_part(uint16_t itab);
+	void reset_pulse_part(float **tables, float width, uint16_t itab);
 
 	// init saw tables.
-	void reset_saw();
+	void reset_saw(float **tables, float width, bool parts);
 	// init saw partial table.
-	void reset_saw_part(uint16_t itab);
+	void reset_saw_part(float **tables, float width, uint16_t itab);
 
 	// init sine tables.
-	void reset_sine();
+	void reset_sine(float **tables, float width, bool parts);
 	// init sine partial table.
-	void reset_sine_part(uint16_t itab);
+	void reset_sine_part(float **tables, float width, uint16_t itab);
 
 	// init random tables.
-	void reset_rand();
+	void reset_rand(float **tables, float width, bool parts);
 	// init random partial table.
-	void reset_rand_part(uint16_t itab);
+	void reset_rand_part(float **tables, float width, uint16_t itab);
 
 	// init noise tables.
-	void reset_noise();
+	void reset_noise(float **tables, float width, bool parts);
 	// init noise partial table.
-	void reset_noise_part(uint16_t itab);
+	void reset_noise_part(float **tables, float width, uint16_t itab);
 
 	// post-processors.
-	void reset_filter(uint16_t itab);
-	void reset_normalize(uint16_t itab);
-	void reset_interp(uint16_t itab);
+	void reset_filter(float *frames);
+	void reset_normalize(float *frames);
+	void reset_interp(float *frames);
+
+	// phase-zero.
+	float reset_phase0(const float *frames) const;
 
 	// Hal Chamberlain's pseudo-random linear congruential method.
 	float pseudo_randf ()
@@ -246,11 +441,38 @@ private:
 	float  **m_tables;
 	float    m_phase0;
 
+	// width morphing (next width tables and crossfade amount).
+	float  **m_tables2;
+	float    m_xmorph;
+
 	uint32_t m_srand;
 
 	float    m_min_freq;
 	float    m_max_freq;
 
+	// width morphing mode (as set; as last requested).
+	std::atomic<bool> m_wmorph;
+	bool m_wmorph_test;
+
+	// analytic mode (current shape, or -1 when on tables;
+	// as last requested).
+	int  m_blep;
+	bool m_blep_test;
+
+	// requested shape, width, band-limiting and morphing (packed).
+	std::atomic<uint64_t> m_reset_key;
+
+	// current tables bank (audio thread);
+	// next one, published (sched thread);
+	// and previous one, retired (to reclaim).
+	synthv1_wave_bank *m_wbank;
+
+	std::atomic<synthv1_wave_bank *> m_wbank_next;
+	std::atomic<synthv1_wave_bank *> m_wbank_prev;
+
+	// own tables, regenerated in place (no sched thread; eg. LFO).
+	synthv1_wave_tables *m_wtabs;
+
 	synthv1_wave_sched *m_sched;
 };
 
@@ -295,6 +517,13 @@ public:
 	float sample(float freq)
 		{ return m_wave->sample(m_phase, freq); }
 
+	template <uint32_t NFRAMES = 2>
+	float sample_frames(float freq, float *x)
+		{ return m_wave->sample_frames<NFRAMES>(m_phase, freq, x); }
+
+	float ftab() const
+		{ return m_phase.ftab; }
+
 	// post-iter.
 	void update(float freq)
 		{ m_wave->update(m_phase, freq); }
@@ -1,7 +1,7 @@
 // synthv1widget_lv2.cpp
 //
 /****************************************************************************
-   Copyright (C) 2012-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2012-2026, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -193,7 +193,8 @@ void synthv1widget_lv2::closeEvent ( QCloseEvent *pCloseEvent )
 void synthv1widget_lv2::port_event ( uint32_t port_index,
 	uint32_t buffer_size, uint32_t format, const void *buffer )
 {
-	if (format == 0 && buffer_size == sizeof(float)) {
+	if (format == 0 && buffer_size == sizeof(float)
+		&& port_index < synthv1_lv2::Latency) {
 		const synthv1::ParamIndex index
 			= synthv1::ParamIndex(port_index - synthv1_lv2::ParamBase);
 		const float fValue = *(float *) buffer;